@@ -2,9 +2,9 @@
 #version 460 core
 
 in vec3 in_pos;
-in vec3 in_color;
+in vec4 in_color;
 
-out vec3 color;
+out vec4 color;
 
 uniform mat4 projection;
 
@@ -17,11 +17,11 @@ void main() {
 #pragma fragment
 #version 460 core
 
-in vec3 color;
+in vec4 color;
 
 out vec4 FragColor;
 
 void main() {
-    FragColor = vec4(color, 1.0);
+    FragColor = color;
 }
 #pragma tnemgarf
@@ -1,13 +1,18 @@
 #include "astra/astra.hpp"
 #include "glm/ext/matrix_clip_space.hpp"
 
+struct Vertex {
+    glm::vec3 pos;
+    astra::rgba8 color;
+};
+
 class Indev {
 public:
     std::optional<astra::Hermes::ID> hermes_id;
 
     std::shared_ptr<gloo::Shader> shader;
     std::unique_ptr<gloo::VertexArray> vao;
-    std::unique_ptr<gloo::Buffer<float>> vbo;
+    std::unique_ptr<gloo::Buffer<Vertex>> vbo;
     glm::mat4 projection{};
 
     Indev();
@@ -22,7 +27,7 @@ private:
 };
 
 Indev::Indev() {
-    hermes_id = astra::g.hermes->acquire_id();
+    hermes_id = astra::g.hermes->acquire_id("Indev");
     astra::g.hermes->subscribe<astra::Update>(*hermes_id, [this](const auto e) { update(e->dt); });
     astra::g.hermes->subscribe<astra::Draw>(*hermes_id, [this](const auto) { draw(); });
     astra::g.hermes->subscribe<sdl3::KeyboardEvent>(*hermes_id, [this](const auto e) { keyboard_event_callback_(e); });
@@ -34,18 +39,17 @@ Indev::Indev() {
     const auto in_pos_loc = shader->try_get_attrib_location("in_pos").value();
     const auto in_color_loc = shader->try_get_attrib_location("in_color").value();
     vao = gloo::VertexArrayBuilder()
-                  .attrib(in_pos_loc, 3, GL_FLOAT, GL_FALSE, 0, 0)
-                  .attrib(in_color_loc, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0)
+                  .attrib(in_pos_loc, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, pos), 0)
+                  .attrib(in_color_loc, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(Vertex, color), 0)
                   .build();
 
-    vbo = std::make_unique<gloo::Buffer<float>>(6 * 3);
-    // clang-format off
+    constexpr auto red = astra::rgba8::hex(0xff0000);
+    vbo = std::make_unique<gloo::Buffer<Vertex>>(3);
     vbo->add({
-        100.0f, 100.0f, 0.0f, 1.0f, 0.0f, 0.0f,
-        150.0f, 100.0f, 0.0f, 1.0f, 0.0f, 0.0f,
-        100.0f, 150.0f, 0.0f, 1.0f, 0.0f, 0.0f
+            {{100.0f, 100.0f, 0.0f}, red},
+            {{150.0f, 100.0f, 0.0f}, red},
+            {{100.0f, 150.0f, 0.0f}, red},
     });
-    // clang-format on
     vbo->sync();
 }
 
@@ -60,7 +64,7 @@ void Indev::update(double dt) {
 }
 
 void Indev::draw() {
-    glViewport(0, 0, astra::g.window->width(), astra::g.window->height());
+    gloo::state::viewport({0, 0, astra::g.window->width(), astra::g.window->height()});
 
     gloo::clear(astra::rgb(0x0f0f0f), GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -68,8 +72,8 @@ void Indev::draw() {
     shader->uniform_mat4("projection", projection);
 
     vao->bind();
-    vbo->bind(0, 0, 6 * sizeof(float));
-    glDrawArrays(GL_TRIANGLES, 0, 3);
+    vbo->bind(0, 0, sizeof(Vertex));
+    gloo::draw_arrays(GL_TRIANGLES, 0, 3);
     vbo->unbind(0);
     vao->unbind();
 }
@@ -1,20 +1,31 @@
 #pragma once
 
+#include "astra/core/binlog.hpp"
 #include "astra/core/color.hpp"
+#include "astra/core/color_kernels.hpp"
 #include "astra/core/globals.hpp"
 #include "astra/core/hermes.hpp"
 #include "astra/core/init.hpp"
 #include "astra/core/log.hpp"
 #include "astra/core/payloads.hpp"
 #include "astra/core/types.hpp"
+#include "astra/gfx/gradient.hpp"
 #include "astra/util/constexpr_hash.hpp"
 #include "astra/util/enum_class_helpers.hpp"
 #include "astra/util/is_any_of.hpp"
 #include "astra/util/module/dear.hpp"
+#include "astra/util/module/io_service.hpp"
+#include "astra/util/module/script.hpp"
 #include "astra/util/module/timer_mgr.hpp"
+#include "astra/util/module/tweener.hpp"
+#include "astra/util/noise.hpp"
 #include "astra/util/platform.hpp"
+#include "astra/util/profile.hpp"
 #include "astra/util/rng.hpp"
+#include "astra/util/sampling.hpp"
+#include "astra/util/slot_map.hpp"
 #include "astra/util/time.hpp"
+#include "astra/util/vfs.hpp"
 
 #include "gloo/gloo.hpp"
 
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <spdlog/common.h>
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/* Binary log, for messages that are only read after the fact
+ *
+ * ASTRA_BLOG_* calls don't format anything: each call site is assigned an ID the first time it runs, and after that a
+ * message is the ID, a timestamp and the raw argument bytes, memcpy'd into a per-thread buffer. A writer thread does
+ * the file I/O when a buffer fills up (and on every error). Nothing is recorded until binlog::open() is called, the
+ * engine doesn't open a file on its own. The `alogdump` tool turns a file back into text. Layout (little-endian):
+ *
+ *   AlogHeader
+ *   records, each an AlogRecord followed by record.size bytes:
+ *     record.site == ALOG_SITE_DEFINITION  AlogSite, arg types, file name, format string
+ *     otherwise                            the arguments of that site, in order
+ *
+ * Arguments are widened so the decoder doesn't need the original types: integers and enums to 64 bits, floats to
+ * double. Strings are a u32 length and the bytes. Anything else doesn't compile, format it first and pass a string.
+ */
+
+namespace astra {
+constexpr std::array<char, 4> ALOG_MAGIC{'A', 'L', 'O', 'G'};
+constexpr std::uint32_t ALOG_VERSION = 1;
+constexpr std::uint32_t ALOG_SITE_DEFINITION = 0;
+
+enum class AlogArg : std::uint8_t {
+    Bool = 0,
+    Char = 1,
+    Int = 2,
+    Uint = 3,
+    Float = 4,
+    Pointer = 5,
+    String = 6,
+};
+
+struct AlogHeader {
+    std::array<char, 4> magic;
+    std::uint32_t version;
+    std::int64_t start_unix_ns; // wall clock at AlogRecord::time_ns == 0
+};
+static_assert(sizeof(AlogHeader) == 16);
+
+struct AlogRecord {
+    std::uint32_t site;
+    std::uint32_t size;
+    std::uint64_t time_ns;
+};
+static_assert(sizeof(AlogRecord) == 16);
+
+struct AlogSite {
+    std::uint32_t id;
+    std::uint32_t line;
+    std::uint8_t level; // spdlog::level::level_enum
+    std::uint8_t arg_count;
+    std::uint16_t file_size;
+    std::uint32_t format_size;
+};
+static_assert(sizeof(AlogSite) == 16);
+
+namespace binlog {
+/// One per call site, the macros make it a function-local static
+struct Site {
+    spdlog::level::level_enum level;
+    std::string_view format;
+    std::string_view file;
+    std::uint32_t line;
+
+    std::atomic<std::uint32_t> id{0};
+    std::atomic<std::uint32_t> generation{0}; // which open() the id belongs to
+};
+
+bool open(const std::filesystem::path &path);
+void close();
+
+/// Blocks until everything logged so far, from every thread, has been handed to the OS
+void flush();
+
+[[nodiscard]] bool is_open();
+
+namespace detail {
+template<typename T>
+consteval AlogArg arg_type() {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::same_as<U, bool>) return AlogArg::Bool;
+    else if constexpr (std::same_as<U, char>) return AlogArg::Char;
+    else if constexpr (std::is_enum_v<U>) return arg_type<std::underlying_type_t<U>>();
+    else if constexpr (std::signed_integral<U>) return AlogArg::Int;
+    else if constexpr (std::unsigned_integral<U>) return AlogArg::Uint;
+    else if constexpr (std::floating_point<U>) return AlogArg::Float;
+    else if constexpr (std::convertible_to<const U &, std::string_view>) return AlogArg::String;
+    else if constexpr (std::is_pointer_v<U>) return AlogArg::Pointer;
+    else static_assert(sizeof(U) == 0, "Unsupported binary log argument, format it into a string first");
+}
+
+template<typename T>
+std::size_t arg_size(const T &value) {
+    if constexpr (arg_type<T>() == AlogArg::String) return sizeof(std::uint32_t) + std::string_view(value).size();
+    else return 8;
+}
+
+template<typename T>
+std::byte *encode(std::byte *out, const T &value) {
+    constexpr auto type = arg_type<T>();
+    if constexpr (type == AlogArg::String) {
+        const auto s = std::string_view(value);
+        const auto size = static_cast<std::uint32_t>(s.size());
+        std::memcpy(out, &size, sizeof(size));
+        std::memcpy(out + sizeof(size), s.data(), s.size());
+        return out + sizeof(size) + s.size();
+    } else {
+        std::uint64_t bits = 0;
+        if constexpr (type == AlogArg::Float) {
+            const auto d = static_cast<double>(value);
+            std::memcpy(&bits, &d, sizeof(d));
+        } else if constexpr (type == AlogArg::Pointer) {
+            bits = reinterpret_cast<std::uintptr_t>(value);
+        } else if constexpr (type == AlogArg::Int) {
+            bits = static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+        } else {
+            bits = static_cast<std::uint64_t>(value);
+        }
+        std::memcpy(out, &bits, sizeof(bits));
+        return out + sizeof(bits);
+    }
+}
+
+void append(Site &site, std::span<const AlogArg> types, std::span<const std::byte> args);
+} // namespace detail
+
+template<typename... Args>
+void write(Site &site, const Args &...args) {
+    if (!is_open()) return;
+
+    static constexpr std::array<AlogArg, sizeof...(Args)> types{detail::arg_type<Args>()...};
+    const std::size_t size = (std::size_t{0} + ... + detail::arg_size(args));
+
+    std::array<std::byte, 256> small;
+    std::vector<std::byte> large;
+    auto out = small.data();
+    if (size > small.size()) {
+        large.resize(size);
+        out = large.data();
+    }
+
+    const auto begin = out;
+    ((out = detail::encode(out, args)), ...);
+    detail::append(site, types, {begin, size});
+}
+} // namespace binlog
+} // namespace astra
+
+#define ASTRA_BLOG_(level_, format_, ...)                                                                              \
+    do {                                                                                                               \
+        static astra::binlog::Site astra_blog_site_{level_, format_, __FILE__, static_cast<std::uint32_t>(__LINE__)};  \
+        astra::binlog::write(astra_blog_site_ __VA_OPT__(, ) __VA_ARGS__);                                             \
+    } while (false)
+
+#define ASTRA_BLOG_TRACE(format, ...) ASTRA_BLOG_(spdlog::level::trace, format __VA_OPT__(, ) __VA_ARGS__)
+#define ASTRA_BLOG_DEBUG(format, ...) ASTRA_BLOG_(spdlog::level::debug, format __VA_OPT__(, ) __VA_ARGS__)
+#define ASTRA_BLOG_INFO(format, ...) ASTRA_BLOG_(spdlog::level::info, format __VA_OPT__(, ) __VA_ARGS__)
+#define ASTRA_BLOG_WARN(format, ...) ASTRA_BLOG_(spdlog::level::warn, format __VA_OPT__(, ) __VA_ARGS__)
+#define ASTRA_BLOG_ERROR(format, ...) ASTRA_BLOG_(spdlog::level::err, format __VA_OPT__(, ) __VA_ARGS__)
+#define ASTRA_BLOG_CRITICAL(format, ...) ASTRA_BLOG_(spdlog::level::critical, format __VA_OPT__(, ) __VA_ARGS__)
@@ -6,6 +6,9 @@
 #include <glm/vec4.hpp>
 #include <imgui.h>
 
+#include <cstdint>
+#include <type_traits>
+
 // fuck windows
 #if defined(RGB)
 #undef RGB
@@ -114,6 +117,41 @@ HSV hsva_f(float h, float s, float v, float a);
 
 HSV hsv(float h, float s, float v);
 
+/* Packed 8-bit color with no vtable, for vertex streams and other bulk storage
+ *
+ * Four bytes in r, g, b, a order, the layout of a normalized GL_UNSIGNED_BYTE vec4 attribute and of ImU32. Converts
+ * to and from RGB/HSL/HSV, but is itself a plain value: trivially copyable and constexpr from hex.
+ */
+struct rgba8 {
+    std::uint8_t r{0};
+    std::uint8_t g{0};
+    std::uint8_t b{0};
+    std::uint8_t a{255};
+
+    constexpr rgba8() = default;
+    constexpr rgba8(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255);
+
+    explicit rgba8(const RGB &rgb);
+    explicit rgba8(const HSL &hsl);
+    explicit rgba8(const HSV &hsv);
+
+    /// 0xRRGGBB, opaque
+    static constexpr rgba8 hex(std::uint32_t hex);
+    /// 0xRRGGBBAA
+    static constexpr rgba8 hexa(std::uint32_t hex);
+
+    /// r in the lowest byte
+    [[nodiscard]] constexpr std::uint32_t packed() const;
+
+    [[nodiscard]] glm::vec4 gl_color() const;
+    [[nodiscard]] RGB rgb() const;
+
+    friend constexpr bool operator==(const rgba8 &lhs, const rgba8 &rhs) = default;
+};
+
+static_assert(sizeof(rgba8) == 4);
+static_assert(std::is_trivially_copyable_v<rgba8>);
+
 namespace rng {
 RGB rgb();
 RGB rgba();
@@ -127,6 +165,31 @@ RGB rgba(
 } // namespace rng
 } // namespace astra
 
+constexpr astra::rgba8::rgba8(const std::uint8_t r, const std::uint8_t g, const std::uint8_t b, const std::uint8_t a)
+    : r(r),
+      g(g),
+      b(b),
+      a(a) {}
+
+constexpr astra::rgba8 astra::rgba8::hex(const std::uint32_t hex) {
+    return {static_cast<std::uint8_t>(hex >> 16 & 0xff),
+            static_cast<std::uint8_t>(hex >> 8 & 0xff),
+            static_cast<std::uint8_t>(hex & 0xff),
+            255};
+}
+
+constexpr astra::rgba8 astra::rgba8::hexa(const std::uint32_t hex) {
+    return {static_cast<std::uint8_t>(hex >> 24 & 0xff),
+            static_cast<std::uint8_t>(hex >> 16 & 0xff),
+            static_cast<std::uint8_t>(hex >> 8 & 0xff),
+            static_cast<std::uint8_t>(hex & 0xff)};
+}
+
+constexpr std::uint32_t astra::rgba8::packed() const {
+    return static_cast<std::uint32_t>(r) | static_cast<std::uint32_t>(g) << 8 | static_cast<std::uint32_t>(b) << 16 |
+           static_cast<std::uint32_t>(a) << 24;
+}
+
 template<>
 struct fmt::formatter<astra::RGB> {
     bool zero_padding = false;
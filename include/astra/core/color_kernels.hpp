@@ -0,0 +1,45 @@
+#pragma once
+
+#include "astra/core/color.hpp"
+
+#include <glm/vec4.hpp>
+
+#include <cstdint>
+#include <span>
+
+/* Color conversions over whole arrays
+ *
+ * Colors are plain glm::vec4 (r, g, b, a in [0, 1], or h in degrees, s, l/v, a for HSL/HSV), and packed colors are
+ * rgba8 or std::uint32_t with r in the lowest byte, the same layout as ImU32 and a GL_UNSIGNED_BYTE vertex attribute.
+ * There's no virtual call per element and no branching on the hue sector, the inner loops are selects and min/max
+ * that compilers vectorize. out must be at least as long as in, converting in place is fine.
+ */
+
+namespace astra::color {
+void hsl_to_rgb(std::span<const glm::vec4> in, std::span<glm::vec4> out);
+void rgb_to_hsl(std::span<const glm::vec4> in, std::span<glm::vec4> out);
+void hsv_to_rgb(std::span<const glm::vec4> in, std::span<glm::vec4> out);
+void rgb_to_hsv(std::span<const glm::vec4> in, std::span<glm::vec4> out);
+
+// alpha is passed through untouched
+void srgb_to_linear(std::span<const glm::vec4> in, std::span<glm::vec4> out);
+void linear_to_srgb(std::span<const glm::vec4> in, std::span<glm::vec4> out);
+
+/// Rounds and clamps to [0, 255]
+void pack(std::span<const glm::vec4> in, std::span<std::uint32_t> out);
+void pack(std::span<const glm::vec4> in, std::span<rgba8> out);
+void unpack(std::span<const std::uint32_t> in, std::span<glm::vec4> out);
+void unpack(std::span<const rgba8> in, std::span<glm::vec4> out);
+
+/// Same as calling gl_color() on each one, without the virtual call
+void unpack(std::span<const RGB> in, std::span<glm::vec4> out);
+
+/// Palette cycling for HSL/HSV arrays, keeps hues in [0, 360)
+void rotate_hue(std::span<glm::vec4> colors, float offset);
+
+// Single-color versions of the kernels, the RGB/HSL/HSV constructors use these
+glm::vec4 hsl_to_rgb(glm::vec4 hsla);
+glm::vec4 rgb_to_hsl(glm::vec4 rgba);
+glm::vec4 hsv_to_rgb(glm::vec4 hsva);
+glm::vec4 rgb_to_hsv(glm::vec4 rgba);
+} // namespace astra::color
@@ -3,7 +3,9 @@
 #include "astra/core/hermes.hpp"
 #include "astra/gfx/shader_mgr.hpp"
 #include "astra/util/module/dear.hpp"
+#include "astra/util/module/io_service.hpp"
 #include "astra/util/time.hpp"
+#include "gloo/gpu_timer.hpp"
 #include "sdl3_raii/window.hpp"
 
 #include <memory>
@@ -14,9 +16,12 @@ struct Globals {
     std::unique_ptr<Hermes> hermes{nullptr};
     std::unique_ptr<sdl3::Window> window{nullptr};
     std::unique_ptr<Dear> dear{nullptr};
+    std::unique_ptr<IoService> io{nullptr};
 
     std::unique_ptr<ShaderMgr> shaders{nullptr};
 
+    std::unique_ptr<gloo::GpuTimer> gpu_timer{nullptr}; // only with ASTRA_PROFILE_ENABLED
+
     bool running{false};
     FrameCounter frame_counter;
 
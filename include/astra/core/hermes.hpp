@@ -2,15 +2,23 @@
 
 #include "astra/util/constexpr_hash.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <ranges>
 #include <span>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
-#define HERMES_TAG_MEMBER(name) constexpr static std::uint32_t HERMES_MESSENGER_TAG{astra::murmur_x86_32(#name, 0)};
+#define HERMES_TAG_MEMBER(name)                                                                                        \
+    constexpr static std::uint32_t HERMES_MESSENGER_TAG{astra::murmur_x86_32(#name, 0)};                               \
+    constexpr static std::string_view HERMES_MESSENGER_NAME{#name};
 
 namespace astra {
 template<typename T>
@@ -23,7 +31,23 @@ class Hermes {
 public:
     using ID = std::size_t;
 
-    ID acquire_id();
+    /// Time spent in one subscriber's callback for one message type, only recorded with ASTRA_PROFILE_ENABLED and
+    /// after set_stats_enabled(true)
+    struct CallStats {
+        std::uint64_t calls{0};
+        std::int64_t total_ns{0};
+        std::int64_t max_ns{0};
+    };
+
+    struct SubscriberStats {
+        std::string_view message;
+        std::string_view subscriber; // empty if it was never named
+        ID id;
+        CallStats stats;
+    };
+
+    /// The name is what shows up next to this ID's timings in the debug overlay
+    ID acquire_id(std::string name = {});
     void release_id(ID id);
 
     template<typename T, typename Func>
@@ -46,29 +70,61 @@ public:
         requires HasAstraTag<T>
     void uncapture(ID id, bool force = false);
 
+    void set_stats_enabled(bool enabled);
+    [[nodiscard]] bool stats_enabled() const;
+
+    /// Every subscriber that has been called at least once since the last reset
+    [[nodiscard]] std::vector<SubscriberStats> stats() const;
+    void reset_stats();
+
 private:
+    struct Subscriber_ {
+        std::unique_ptr<Receiver> receiver; // boxed, growing the vector mid-publish doesn't move a running callback
+        CallStats stats;
+    };
+
     ID next_id_ = 0;
     std::vector<ID> recycled_ids_{};
+    std::vector<std::string> names_{};
 
     std::unordered_map<std::uint32_t, std::optional<ID>> captures_;
-    std::unordered_map<std::uint32_t, std::vector<Receiver>> receivers_;
+    std::unordered_map<std::uint32_t, std::vector<Subscriber_>> receivers_;
+    std::unordered_map<std::uint32_t, std::string_view> message_names_;
+
+    bool stats_enabled_{false};
+
+    std::size_t publish_depth_{0};
+    std::vector<std::unique_ptr<Receiver>> retired_{}; // replaced mid-publish, destroyed once the outermost returns
+
+    void retire_(std::unique_ptr<Receiver> receiver);
+    void call_(std::vector<Subscriber_> &receivers, ID id, Payload payload) const;
 
     template<typename T, typename... Args>
     std::span<std::byte> make_payload_(Args &&...args);
 };
 } // namespace astra
 
-inline astra::Hermes::ID astra::Hermes::acquire_id() {
-    if (recycled_ids_.empty()) return next_id_++;
+inline astra::Hermes::ID astra::Hermes::acquire_id(std::string name) {
+    ID id;
+    if (recycled_ids_.empty()) {
+        id = next_id_++;
+    } else {
+        id = recycled_ids_.back();
+        recycled_ids_.pop_back();
+    }
 
-    const auto id = recycled_ids_.back();
-    recycled_ids_.pop_back();
+    if (names_.size() <= id) names_.resize(id + 1);
+    names_[id] = std::move(name);
     return id;
 }
 
 inline void astra::Hermes::release_id(const ID id) {
-    for (auto &receivers: receivers_ | std::views::values)
-        if (receivers.size() > id) receivers[id] = nullptr;
+    for (auto &receivers: receivers_ | std::views::values) {
+        if (receivers.size() <= id) continue;
+        retire_(std::move(receivers[id].receiver));
+        receivers[id] = {};
+    }
+    if (names_.size() > id) names_[id].clear();
 
     for (auto &capture: captures_ | std::views::values)
         if (capture && *capture == id) capture.reset();
@@ -81,30 +137,40 @@ template<typename T, typename Func>
 void astra::Hermes::subscribe(ID id, Func &&f) {
     auto &receivers = receivers_[T::HERMES_MESSENGER_TAG];
     if (receivers.size() <= id) receivers.resize(id + 1);
-    receivers[id] = [f = std::forward<Func>(f)](const Payload buffer) {
-        f(reinterpret_cast<const T *>(buffer.data()));
-    };
+    retire_(std::exchange(
+            receivers[id].receiver,
+            std::make_unique<Receiver>([f = std::forward<Func>(f)](const Payload buffer) {
+                f(reinterpret_cast<const T *>(buffer.data()));
+            })));
+    message_names_[T::HERMES_MESSENGER_TAG] = T::HERMES_MESSENGER_NAME;
 }
 
 template<typename T>
     requires astra::HasAstraTag<T>
 void astra::Hermes::unsubscribe(ID id) {
     auto &receivers = receivers_[T::HERMES_MESSENGER_TAG];
-    if (receivers.size() > id) receivers[id] = nullptr;
+    if (receivers.size() <= id) return;
+
+    retire_(std::move(receivers[id].receiver));
+    receivers[id] = {};
 }
 
 template<typename T, typename... Args>
     requires astra::HasAstraTag<T>
 void astra::Hermes::publish(Args &&...args) {
     const auto payload = make_payload_<T>(std::forward<Args>(args)...);
+    ++publish_depth_;
+    auto &receivers = receivers_[T::HERMES_MESSENGER_TAG];
     if (auto cap_id_opt = captures_[T::HERMES_MESSENGER_TAG]; cap_id_opt) {
-        if (receivers_[T::HERMES_MESSENGER_TAG].size() > *cap_id_opt) {
-            if (auto &r = receivers_[T::HERMES_MESSENGER_TAG][*cap_id_opt]; r) r(payload);
+        if (receivers.size() > *cap_id_opt) {
+            if (receivers[*cap_id_opt].receiver) call_(receivers, *cap_id_opt, payload);
         }
     } else {
-        for (auto &r: receivers_[T::HERMES_MESSENGER_TAG])
-            if (r) r(payload);
+        // by index, a callback that subscribes something new can reallocate the vector under us
+        for (ID id = 0; id < receivers.size(); ++id)
+            if (receivers[id].receiver) call_(receivers, id, payload);
     }
+    if (--publish_depth_ == 0) retired_.clear();
     operator delete(payload.data(), payload.size());
 }
 
@@ -121,6 +187,59 @@ void astra::Hermes::uncapture(ID id, bool force) {
         captures_[T::HERMES_MESSENGER_TAG].reset();
 }
 
+inline void astra::Hermes::set_stats_enabled(const bool enabled) {
+    stats_enabled_ = enabled;
+}
+
+inline bool astra::Hermes::stats_enabled() const {
+    return stats_enabled_;
+}
+
+inline std::vector<astra::Hermes::SubscriberStats> astra::Hermes::stats() const {
+    std::vector<SubscriberStats> result;
+    for (const auto &[tag, receivers]: receivers_) {
+        const auto name = message_names_.find(tag);
+        for (ID id = 0; id < receivers.size(); ++id) {
+            if (receivers[id].stats.calls == 0) continue;
+            result.push_back(
+                    {name != message_names_.end() ? name->second : std::string_view{},
+                     id < names_.size() ? std::string_view(names_[id]) : std::string_view{},
+                     id,
+                     receivers[id].stats});
+        }
+    }
+    return result;
+}
+
+inline void astra::Hermes::reset_stats() {
+    for (auto &receivers: receivers_ | std::views::values)
+        for (auto &s: receivers) s.stats = {};
+}
+
+inline void astra::Hermes::retire_(std::unique_ptr<Receiver> receiver) {
+    // it may be the callback that's running, or one further up the stack
+    if (receiver && publish_depth_ > 0) retired_.push_back(std::move(receiver));
+}
+
+inline void astra::Hermes::call_(std::vector<Subscriber_> &receivers, const ID id, const Payload payload) const {
+    // the callback may unsubscribe itself or grow the vector, neither destroys or moves what this refers to
+    const auto &receiver = *receivers[id].receiver;
+#if defined(ASTRA_PROFILE_ENABLED)
+    if (stats_enabled_) {
+        const auto begin = std::chrono::steady_clock::now();
+        receiver(payload);
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+
+        auto &stats = receivers[id].stats; // looked up again, the callback may have grown the vector
+        ++stats.calls;
+        stats.total_ns += ns.count();
+        stats.max_ns = std::max(stats.max_ns, ns.count());
+        return;
+    }
+#endif
+    receiver(payload);
+}
+
 template<typename T, typename... Args>
 std::span<std::byte> astra::Hermes::make_payload_(Args &&...args) {
     return std::span(reinterpret_cast<std::byte *>(new T{std::forward<Args>(args)...}), sizeof(T));
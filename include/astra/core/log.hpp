@@ -10,12 +10,40 @@
 #include <spdlog/sinks/dist_sink.h>
 #include <spdlog/spdlog.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 namespace astra {
+/// Every sink in here gets every message, on the async writer thread when async logging is on
 std::shared_ptr<spdlog::sinks::dist_sink_mt> logger_sinks();
 
 std::shared_ptr<spdlog::logger> logger();
+
+/// What a logging thread does when the async queue is full
+enum class LogOverflow {
+    Block, // wait for the writer, nothing is lost
+    Drop,  // throw the message away
+    Sample // past half full keep every sample_every-th message below warn, drop when full
+};
+
+struct AsyncLogOptions {
+    std::size_t capacity{8192}; // rounded up to a power of two
+    LogOverflow overflow{LogOverflow::Block};
+    std::uint32_t sample_every{8};
+};
+
+/* Move sink work (pattern formatting, console and file writes) onto a background writer thread
+ *
+ * Logging then costs a copy of the already formatted message into a lock-free ring, the writer formats it for each
+ * sink and flushes the file once per drained batch. Safe to switch while other threads are logging, turning it off
+ * drains whatever is still queued.
+ */
+void enable_async_logging(const AsyncLogOptions &options = {});
+void disable_async_logging();
+
+/// Messages thrown away by the Drop and Sample policies since async logging was enabled
+std::uint64_t async_log_dropped();
 } // namespace astra
 
 #define ASTRA_LOG_TRACE(...) SPDLOG_LOGGER_TRACE(astra::logger(), __VA_ARGS__)
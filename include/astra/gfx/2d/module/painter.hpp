@@ -8,17 +8,23 @@
 namespace astra {
 class Painter {
 public:
+    // 12 bytes, color goes to the shader as attrib(loc, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(Vertex, color), ...)
+    struct Vertex {
+        glm::vec2 pos;
+        rgba8 color;
+    };
+
     Painter(sdl3::Window *window);
 
-    void point(glm::vec2 p, const Color &color);
+    void point(glm::vec2 p, rgba8 color);
 
-    void line(glm::vec2 p0, glm::vec2 p1, const Color &color);
+    void line(glm::vec2 p0, glm::vec2 p1, rgba8 color);
 
-    void triangle(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, const Color &color);
+    void triangle(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, rgba8 color);
 
-    void rectangle(glm::vec2 p, glm::vec2 size, const Color &color);
+    void rectangle(glm::vec2 p, glm::vec2 size, rgba8 color);
 
-    void ellipse(glm::vec2 p, glm::vec2 size, const Color &color);
+    void ellipse(glm::vec2 p, glm::vec2 size, rgba8 color);
 
 private:
     sdl3::Window *window_;
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "astra/util/vfs.hpp"
+#include "gloo/texture.hpp"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+
+/* ATEX texture container
+ *
+ * Written offline by the `atexconv` tool, loaded at runtime through the VFS (a mapped loose file or a view into a
+ * mounted pack) and uploaded mip by mip straight from that memory, so there is no decode step at startup.
+ * Layout (little-endian):
+ *
+ *   AtexHeader
+ *   AtexMip[header.mip_count]          mip 0 is the full size image
+ *   pixel data, each mip starting on an ATEX_DATA_ALIGNMENT boundary
+ */
+
+namespace astra {
+constexpr std::array<char, 4> ATEX_MAGIC{'A', 'T', 'E', 'X'};
+constexpr std::uint32_t ATEX_VERSION = 1;
+constexpr std::uint64_t ATEX_DATA_ALIGNMENT = 16;
+
+enum class AtexFormat : std::uint32_t {
+    Rgba8Premultiplied = 0,
+    Bc7Premultiplied = 1,
+};
+
+struct AtexHeader {
+    std::array<char, 4> magic;
+    std::uint32_t version;
+    AtexFormat format;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t mip_count;
+};
+static_assert(sizeof(AtexHeader) == 24);
+
+struct AtexMip {
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint32_t width;
+    std::uint32_t height;
+};
+static_assert(sizeof(AtexMip) == 24);
+
+class AtexFile {
+    friend std::optional<AtexFile> open_atex(VfsFile file, const std::filesystem::path &path);
+
+public:
+    [[nodiscard]] const AtexHeader &header() const;
+    [[nodiscard]] std::span<const AtexMip> mips() const;
+    [[nodiscard]] std::span<const std::byte> mip_data(std::size_t level) const;
+
+private:
+    VfsFile file_;
+
+    explicit AtexFile(VfsFile file);
+};
+
+/// Read and validate an ATEX file, uncompressed pack entries and loose files are not copied
+std::optional<AtexFile> open_atex(const std::filesystem::path &path);
+
+/// Validate an already read ATEX file, the path is only used for error messages
+std::optional<AtexFile> open_atex(VfsFile file, const std::filesystem::path &path);
+
+/// Upload every mip of an ATEX file into a new texture
+std::unique_ptr<gloo::Texture> load_atex_texture(const std::filesystem::path &path);
+std::unique_ptr<gloo::Texture> load_atex_texture(const AtexFile &atex, const std::filesystem::path &path);
+
+/// Read the file on the IoService workers, upload and call back on the main thread (nullptr on failure)
+void load_atex_texture_async(
+        const std::filesystem::path &path, std::function<void(std::unique_ptr<gloo::Texture>)> callback);
+} // namespace astra
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "astra/core/color.hpp"
+#include "gloo/texture.hpp"
+
+#include <glm/vec4.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <vector>
+
+/* Multi-stop color gradients baked into a lookup table
+ *
+ * The stops are interpolated once, when the gradient is built, so sampling is an index computation and a load instead
+ * of per-element HSL/OKLab math. Lookups are nearest-entry, a resolution of 256 is already finer than 8-bit color.
+ * The same table can be uploaded as a 1D texture, sample it in a shader at
+ *
+ *   texture(lut, t * (resolution - 1) / resolution + 0.5 / resolution)
+ *
+ * so that t = 0 and t = 1 land on the centers of the first and last texels.
+ */
+
+namespace astra {
+class Gradient {
+public:
+    enum class Space {
+        RGB,
+        HSL,  // hue takes the short way around
+        OKLab // perceptually even steps, no muddy midpoints
+    };
+
+    struct Stop {
+        float position; // [0, 1], stops don't need to be sorted
+        rgba8 color;
+    };
+
+    Gradient(std::initializer_list<Stop> stops, Space space = Space::OKLab, std::size_t resolution = 256);
+    Gradient(std::span<const Stop> stops, Space space = Space::OKLab, std::size_t resolution = 256);
+
+    /// t is clamped to [0, 1]
+    [[nodiscard]] rgba8 sample(float t) const;
+    void sample(std::span<const float> t, std::span<rgba8> out) const;
+    void sample(std::span<const float> t, std::span<glm::vec4> out) const;
+
+    /// t + offset wraps around instead of clamping, for palette cycling without rotating every color. The last stop
+    /// should repeat the first one's color so the wrap is seamless
+    [[nodiscard]] rgba8 sample_cyclic(float t, float offset = 0.0f) const;
+    void sample_cyclic(std::span<const float> t, float offset, std::span<rgba8> out) const;
+
+    [[nodiscard]] std::span<const rgba8> table() const;
+    [[nodiscard]] std::size_t resolution() const;
+
+    /// GL_RGBA8 1D texture with linear filtering and clamped edges, already filled with the table
+    [[nodiscard]] std::unique_ptr<gloo::Texture> make_texture() const;
+
+    /// Refill a texture made by make_texture() (or anything 1D, RGBA8 and resolution() wide)
+    void upload(gloo::Texture &texture) const;
+
+private:
+    std::vector<rgba8> table_;
+    float scale_;
+};
+} // namespace astra
@@ -4,6 +4,7 @@
 #include "gloo/shader.hpp"
 
 #include <filesystem>
+#include <functional>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -36,6 +37,10 @@ public:
 
     std::shared_ptr<gloo::Shader> add_shader(const std::filesystem::path &path);
 
+    /// Read the shader on the IoService workers, compile and call back on the main thread (nullptr on failure)
+    void add_shader_async(
+            const std::filesystem::path &path, std::function<void(std::shared_ptr<gloo::Shader>)> callback);
+
     void draw_editor();
 
 private:
@@ -50,6 +55,8 @@ private:
     void parse_shader_stages_(ShaderSrc &shader_src);
     std::optional<std::string> parse_includes_(std::unordered_set<std::string> &deps, const std::string &src);
 
+    std::shared_ptr<gloo::Shader> build_shader_(const ShaderSrc &shader_src);
+
     void try_recompile_shader_(const std::string &path, const std::string &src);
     void sub_pending_shaders_();
 };
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
-#include <queue>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
 
 namespace astra {
 class Averager {
@@ -9,12 +14,14 @@ public:
     virtual ~Averager() = default;
 
     virtual void update(double sample) = 0;
+    virtual void update(std::span<const double> samples);
 
     [[nodiscard]] virtual double value() const = 0;
 };
 
-class CMA final : Averager {
+class CMA final : public Averager {
 public:
+    using Averager::update;
     void update(double sample) override;
     [[nodiscard]] double value() const override;
 
@@ -23,30 +30,226 @@ private:
     std::size_t sample_count_{0};
 };
 
-class SMA final : Averager {
+/// Mean of the last sample_count samples, the window is allocated once up front
+class SMA final : public Averager {
 public:
-    std::size_t sample_count{0};
-
-    explicit SMA(double sample_count);
+    explicit SMA(std::size_t sample_count);
 
     void update(double sample) override;
+    void update(std::span<const double> samples) override;
     [[nodiscard]] double value() const override;
 
+    [[nodiscard]] std::size_t sample_count() const;
+
 private:
-    double value_{0.0};
-    std::queue<double> samples_{};
+    std::vector<double> samples_;
+    std::size_t next_{0};
+    std::size_t size_{0};
+    double sum_{0.0};
 };
 
-class EMA final : Averager {
+class EMA final : public Averager {
 public:
     double alpha{0.0};
 
     explicit EMA(double alpha);
 
+    using Averager::update;
     void update(double sample) override;
     [[nodiscard]] double value() const override;
 
 private:
     double value_{0.0};
 };
+
+/* Min (or max) of the last sample_count samples
+ *
+ * Keeps a monotonic queue: a sample that can never be the extremum again (an older one that's beaten by a newer one)
+ * is dropped as soon as the newer one arrives, so the front is always the answer and each sample is pushed and popped
+ * at most once.
+ */
+template<typename Compare>
+class SlidingExtremum final : public Averager {
+public:
+    explicit SlidingExtremum(std::size_t sample_count);
+
+    void update(double sample) override;
+    void update(std::span<const double> samples) override;
+    [[nodiscard]] double value() const override;
+
+    [[nodiscard]] std::size_t sample_count() const;
+
+private:
+    struct Entry_ {
+        std::uint64_t index;
+        double value;
+    };
+
+    std::vector<Entry_> queue_; // ring, capacity sample_count
+    std::size_t head_{0};
+    std::size_t size_{0};
+    std::uint64_t next_index_{0};
+    Compare compare_{};
+
+    Entry_ &at_(std::size_t i);
+};
+
+using SlidingMin = SlidingExtremum<std::less<>>;
+using SlidingMax = SlidingExtremum<std::greater<>>;
+
+/// Population variance of the last sample_count samples, value() is the variance
+class SlidingVariance final : public Averager {
+public:
+    explicit SlidingVariance(std::size_t sample_count);
+
+    void update(double sample) override;
+    void update(std::span<const double> samples) override;
+    [[nodiscard]] double value() const override;
+
+    [[nodiscard]] double mean() const;
+    [[nodiscard]] double stddev() const;
+
+    [[nodiscard]] std::size_t sample_count() const;
+
+private:
+    std::vector<double> samples_;
+    std::size_t next_{0};
+    std::size_t size_{0};
+    double mean_{0.0};
+    double m2_{0.0}; // sum of squared differences from the mean
+
+    void recompute_();
+};
+
+/* Streaming estimate of a single quantile in constant memory (the P² algorithm)
+ *
+ * Tracks five markers whose heights are nudged toward the target quantile with a piecewise-parabolic fit as samples
+ * come in. Cheap and small, but two estimators can't be combined, use DDSketch for anything that has to be merged.
+ */
+class P2Quantile final : public Averager {
+public:
+    explicit P2Quantile(double quantile);
+
+    void update(double sample) override;
+    void update(std::span<const double> samples) override;
+    [[nodiscard]] double value() const override;
+
+    [[nodiscard]] double quantile() const;
+    [[nodiscard]] std::uint64_t count() const;
+
+private:
+    double quantile_;
+    std::uint64_t count_{0};
+
+    std::array<double, 5> heights_{};
+    std::array<double, 5> positions_{};
+    std::array<double, 5> desired_positions_{};
+    std::array<double, 5> increments_{};
+
+    double parabolic_(std::size_t i, double d) const;
+    double linear_(std::size_t i, double d) const;
+};
+
+/* Full distribution sketch with a relative error guarantee (DDSketch)
+ *
+ * Samples go into logarithmic buckets, so any quantile is within relative_accuracy of the true value (ignoring the
+ * lowest buckets once max_bins is hit, which are collapsed first to keep the tail exact). value() is the quantile
+ * given to the constructor, quantile() answers any other.
+ *
+ * Sketches with the same relative_accuracy merge losslessly: give each thread its own and merge them into one on the
+ * reading side. A single sketch isn't thread safe.
+ */
+class DDSketch final : public Averager {
+public:
+    explicit DDSketch(double quantile = 0.5, double relative_accuracy = 0.01, std::size_t max_bins = 2048);
+
+    void update(double sample) override;
+    void update(std::span<const double> samples) override;
+    [[nodiscard]] double value() const override;
+
+    [[nodiscard]] double quantile(double q) const;
+
+    void merge(const DDSketch &other);
+    void clear();
+
+    [[nodiscard]] std::uint64_t count() const;
+    [[nodiscard]] double min() const;
+    [[nodiscard]] double max() const;
+    [[nodiscard]] double relative_accuracy() const;
+
+private:
+    // magnitudes below this all land in the zero bucket
+    static constexpr double MIN_INDEXABLE = 1e-9;
+
+    // dense bucket counts starting at index offset
+    struct Store_ {
+        std::vector<std::uint64_t> bins{};
+        std::int32_t offset{0};
+        std::uint64_t count{0};
+
+        void add(std::int32_t index, std::uint64_t n, std::size_t max_bins);
+        void merge(const Store_ &other, std::size_t max_bins);
+        void collapse(std::size_t max_bins);
+    };
+
+    double quantile_;
+    double relative_accuracy_;
+    double gamma_;
+    double log_gamma_;
+    std::size_t max_bins_;
+
+    Store_ positive_{};
+    Store_ negative_{};
+    std::uint64_t zero_count_{0};
+    double min_;
+    double max_;
+
+    std::int32_t index_(double magnitude) const;
+    double bucket_value_(std::int32_t index) const;
+};
 } // namespace astra
+
+template<typename Compare>
+astra::SlidingExtremum<Compare>::SlidingExtremum(const std::size_t sample_count)
+    : queue_(std::max<std::size_t>(sample_count, 1)) {}
+
+template<typename Compare>
+void astra::SlidingExtremum<Compare>::update(const double sample) {
+    const auto index = next_index_++;
+
+    // anything at the back that this sample beats (or ties) can't be the answer anymore
+    while (size_ > 0 && !compare_(at_(size_ - 1).value, sample)) --size_;
+
+    // the queue is never longer than the window, so the front has expired if the queue is full
+    if (size_ == queue_.size()) {
+        head_ = (head_ + 1) % queue_.size();
+        --size_;
+    }
+    at_(size_) = {index, sample};
+    ++size_;
+
+    if (at_(0).index + queue_.size() <= index) {
+        head_ = (head_ + 1) % queue_.size();
+        --size_;
+    }
+}
+
+template<typename Compare>
+void astra::SlidingExtremum<Compare>::update(const std::span<const double> samples) {
+    for (const auto s: samples) update(s);
+}
+
+template<typename Compare>
+double astra::SlidingExtremum<Compare>::value() const {
+    return size_ > 0 ? queue_[head_].value : 0.0;
+}
+
+template<typename Compare>
+std::size_t astra::SlidingExtremum<Compare>::sample_count() const {
+    return queue_.size();
+}
+
+template<typename Compare>
+typename astra::SlidingExtremum<Compare>::Entry_ &astra::SlidingExtremum<Compare>::at_(const std::size_t i) {
+    return queue_[(head_ + i) % queue_.size()];
+}
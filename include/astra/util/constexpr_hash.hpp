@@ -3,6 +3,7 @@
 #include "astra/core/types.hpp"
 
 #include <cstdint>
+#include <string_view>
 
 namespace astra {
 namespace internal {
@@ -313,6 +314,15 @@ constexpr uint128_t murmur_x64_128(const char *key, const std::uint32_t len, con
 }
 } // namespace internal
 
+constexpr std::uint64_t fnv1a_64(const std::string_view s) {
+    std::uint64_t h = 0xcbf29ce484222325;
+    for (const auto c: s) {
+        h ^= static_cast<std::uint8_t>(c);
+        h *= 0x100000001b3;
+    }
+    return h;
+}
+
 template<uint64_t N>
 constexpr std::uint32_t murmur_x86_32(const char (&s)[N], const std::uint32_t seed) {
     return internal::murmur_x86_32(s, N - 1, seed);
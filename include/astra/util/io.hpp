@@ -2,10 +2,40 @@
 
 #include <SDL3/SDL_surface.h>
 
+#include <cstddef>
 #include <filesystem>
 #include <optional>
+#include <span>
 
 namespace astra {
+class MappedFile {
+    friend std::optional<MappedFile> map_file(const std::filesystem::path &path);
+
+public:
+    ~MappedFile();
+
+    MappedFile(const MappedFile &other) = delete;
+    MappedFile &operator=(const MappedFile &other) = delete;
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    [[nodiscard]] std::span<const std::byte> bytes() const;
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    const std::byte *data_{nullptr};
+    std::size_t size_{0};
+    void *mapping_{nullptr}; // only used on Windows, the file mapping handle
+
+    MappedFile(const std::byte *data, std::size_t size, void *mapping);
+
+    void unmap_();
+};
+
+/// Map a whole file read-only into memory, the mapping lives as long as the returned object
+std::optional<MappedFile> map_file(const std::filesystem::path &path);
+
 SDL_Surface *read_image_to_sdl_surface(const std::filesystem::path &path);
 
 std::optional<std::string> read_file_to_string(const std::filesystem::path &path);
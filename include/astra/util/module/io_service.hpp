@@ -0,0 +1,77 @@
+#pragma once
+
+#include "astra/core/hermes.hpp"
+#include "astra/util/vfs.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace astra {
+/* Reads files through the VFS on a pool of worker threads. Completion callbacks are always invoked on the main
+ * thread, at PreUpdate, so they are free to touch GL and engine state.
+ *
+ * On Linux, files that resolve to disk go through io_uring instead when the kernel supports it: one thread keeps many
+ * reads in flight with a few syscalls per batch. Pack entries and anything the ring can't read still use the pool.
+ */
+class IoService {
+public:
+    using Callback = std::function<void(std::optional<VfsFile>)>;
+    using BatchCallback = std::function<void(std::vector<std::optional<VfsFile>>)>;
+
+    /// 0 threads picks a default based on the hardware concurrency
+    explicit IoService(std::size_t thread_count = 0);
+    ~IoService();
+
+    IoService(const IoService &other) = delete;
+    IoService &operator=(const IoService &other) = delete;
+
+    IoService(IoService &&other) noexcept = delete;
+    IoService &operator=(IoService &&other) noexcept = delete;
+
+    void read(std::filesystem::path path, Callback callback);
+
+    /// One callback once every file has been read, results are in the same order as paths
+    void read_batch(std::vector<std::filesystem::path> paths, BatchCallback callback);
+
+    /// Callbacks that have been submitted but not yet delivered
+    [[nodiscard]] std::size_t pending() const;
+
+    /// Block until every submitted read has finished, then deliver the completions (main thread only)
+    void flush();
+
+private:
+    struct Request_ {
+        std::filesystem::path path;
+        std::function<void(std::optional<VfsFile>)> on_read; // runs on the worker
+    };
+
+    struct Ring_; // defined in io_service.cpp, Linux only
+
+    Hermes::ID hermes_id_;
+
+    std::mutex request_mutex_;
+    std::condition_variable_any request_cv_;
+    std::deque<Request_> requests_;
+
+    std::mutex completion_mutex_;
+    std::condition_variable completion_cv_;
+    std::vector<std::function<void()>> completions_;
+
+    std::atomic<std::size_t> pending_{0}; // one per callback, not per file
+    std::vector<std::jthread> workers_;
+    std::unique_ptr<Ring_> ring_; // null when io_uring isn't available
+
+    void submit_(Request_ request);
+    void submit_to_workers_(Request_ request);
+    void worker_(const std::stop_token &stop_token);
+    void deliver_completions_();
+};
+} // namespace astra
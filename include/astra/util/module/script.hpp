@@ -0,0 +1,156 @@
+#pragma once
+
+#include "astra/core/globals.hpp"
+#include "astra/core/hermes.hpp"
+#include "astra/util/module/timer_mgr.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+
+/* Coroutine scripts driven by a TimerMgr
+ *
+ *   astra::Script blink(Sprite &s) {
+ *       for (int i = 0; i < 3; ++i) {
+ *           s.visible = !s.visible;
+ *           co_await astra::wait(0.25);
+ *       }
+ *       const auto e = co_await astra::event<sdl3::KeyboardEvent>();
+ *       ...
+ *   }
+ *
+ *   const auto id = timers.run(blink(sprite));
+ *
+ * A script runs synchronously up to its first co_await inside run(), after that it's resumed from the TimerMgr's
+ * PreUpdate handler. The returned ID works with cancel/pause/resume like any timer; cancelling destroys the frame,
+ * so don't cancel a script from inside itself. Frames come from a pooled allocator instead of the global heap.
+ */
+
+namespace astra {
+class Script {
+public:
+    struct promise_type {
+        TimerMgr *timers{nullptr};
+        TimerMgr::ID id{TimerMgr::NULL_ID};
+
+        Script get_return_object();
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; } // the TimerMgr destroys finished frames
+
+        void return_void() {}
+        void unhandled_exception() { throw; }
+
+        static void *operator new(std::size_t size);
+        static void operator delete(void *p, std::size_t size);
+    };
+
+    ~Script();
+
+    Script(const Script &other) = delete;
+    Script &operator=(const Script &other) = delete;
+
+    Script(Script &&other) noexcept;
+    Script &operator=(Script &&other) noexcept;
+
+private:
+    friend class TimerMgr;
+
+    std::coroutine_handle<promise_type> handle_;
+
+    explicit Script(std::coroutine_handle<promise_type> handle);
+
+    /// Give up ownership, the TimerMgr takes over destroying the frame
+    std::coroutine_handle<promise_type> release_();
+};
+
+class WaitAwaiter {
+public:
+    explicit WaitAwaiter(double seconds);
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<Script::promise_type> handle) const;
+    void await_resume() const noexcept {}
+
+private:
+    double seconds_;
+};
+
+class NextFrameAwaiter {
+public:
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<Script::promise_type> handle) const;
+    void await_resume() const noexcept {}
+};
+
+/// Resumes at the PreUpdate after the next T is published, with a copy of it. Not for PreUpdate itself, use
+/// next_frame for that.
+template<typename T>
+    requires HasAstraTag<T>
+class EventAwaiter {
+public:
+    EventAwaiter() = default;
+    ~EventAwaiter();
+
+    EventAwaiter(const EventAwaiter &other) = delete;
+    EventAwaiter &operator=(const EventAwaiter &other) = delete;
+
+    EventAwaiter(EventAwaiter &&other) noexcept = delete;
+    EventAwaiter &operator=(EventAwaiter &&other) noexcept = delete;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<Script::promise_type> handle);
+    T await_resume();
+
+private:
+    std::optional<T> payload_{};
+    std::optional<Hermes::ID> hermes_id_{};
+
+    void release_();
+};
+
+/// Resume after a number of seconds, same 1ms resolution as TimerMgr::after
+WaitAwaiter wait(double seconds);
+
+/// Resume at the next PreUpdate
+NextFrameAwaiter next_frame();
+
+template<typename T>
+    requires HasAstraTag<T>
+EventAwaiter<T> event() {
+    return {};
+}
+} // namespace astra
+
+template<typename T>
+    requires astra::HasAstraTag<T>
+astra::EventAwaiter<T>::~EventAwaiter() {
+    release_();
+}
+
+template<typename T>
+    requires astra::HasAstraTag<T>
+void astra::EventAwaiter<T>::await_suspend(std::coroutine_handle<Script::promise_type> handle) {
+    hermes_id_ = g.hermes->acquire_id("EventAwaiter");
+    g.hermes->subscribe<T>(*hermes_id_, [this, handle](const T *p) {
+        // only the first one counts, the subscription is dropped once the script resumes
+        if (payload_) return;
+        payload_ = *p;
+        handle.promise().timers->ready_script_(handle.promise().id);
+    });
+}
+
+template<typename T>
+    requires astra::HasAstraTag<T>
+T astra::EventAwaiter<T>::await_resume() {
+    release_();
+    return std::move(*payload_);
+}
+
+template<typename T>
+    requires astra::HasAstraTag<T>
+void astra::EventAwaiter<T>::release_() {
+    if (!hermes_id_) return;
+    g.hermes->release_id(*hermes_id_);
+    hermes_id_ = std::nullopt;
+}
@@ -1,69 +1,42 @@
 #pragma once
 
 #include "astra/core/hermes.hpp"
+#include "astra/util/slot_map.hpp"
 
+#include <array>
+#include <coroutine>
+#include <cstdint>
 #include <functional>
 #include <optional>
-#include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace astra {
-class TimerMgr {
-    struct Timer {
-        bool paused{false};
-
-        virtual ~Timer() = default;
-        virtual bool update(double dt) = 0;
-        virtual bool fire() = 0;
-    };
-
-    struct EveryTimer final : Timer {
-        std::vector<double> intervals;
-        std::optional<std::size_t> count;
-        std::function<void()> callback;
-        double acc{0.0};
-
-        EveryTimer(std::vector<double> intervals, std::optional<std::size_t> count, std::function<void()> callback);
+class Script;
+class WaitAwaiter;
+class NextFrameAwaiter;
 
-        bool update(double dt) override;
-        bool fire() override;
-    };
-
-    struct UntilTimer final : Timer {
-        std::vector<double> intervals;
-        std::optional<std::size_t> count;
-        std::function<bool()> callback;
-        double acc{0.0};
-
-        UntilTimer(std::vector<double> intervals, std::optional<std::size_t> count, std::function<bool()> callback);
-
-        bool update(double dt) override;
-        bool fire() override;
-    };
-
-    struct AfterTimer final : Timer {
-        std::function<void()> callback;
-        double acc{0.0};
-
-        AfterTimer(double interval, std::function<void()> callback);
-
-        bool update(double dt) override;
-        bool fire() override;
-    };
-
-    struct DuringTimer final : Timer {
-        std::function<void()> callback;
-        std::function<void()> after_callback;
-        double acc{0.0};
-
-        DuringTimer(double duration, std::function<void()> callback, std::function<void()> after_callback);
+template<typename T>
+    requires HasAstraTag<T>
+class EventAwaiter;
+
+/* Timers are kept in a slot map and addressed through generational IDs, so cancelling a timer that already
+ * finished is a harmless no-op. Everything except `during` timers is scheduled on a hierarchical timing wheel
+ * (4 levels of 256 slots, 1ms ticks), so scheduling is O(1) and an update only visits timers that are due. Timers
+ * that are already due when scheduled (zero intervals included) skip the wheel and fire on the next update, even one
+ * shorter than a tick.
+ *
+ * `during` timers fire every update, so they live in parallel arrays instead: the countdown is one sweep over
+ * contiguous doubles, and only the compacted list of expired lanes is looked at afterward. Paused timers are moved
+ * out of those arrays entirely.
+ *
+ * Coroutine scripts (see script.hpp) are timers too, waits go on the wheel without allocating a callback.
+ */
+class TimerMgr {
+public:
+    using ID = std::uint64_t; // SlotMap key
 
-        bool update(double dt) override;
-        bool fire() override;
-    };
+    static constexpr ID NULL_ID = 0;
 
-public:
     TimerMgr();
     ~TimerMgr();
 
@@ -73,55 +46,141 @@ public:
     TimerMgr(TimerMgr &&other) noexcept;
     TimerMgr &operator=(TimerMgr &&other) noexcept;
 
-    void cancel(const std::string &id);
+    void cancel(ID id);
+
+    void pause(ID id);
+    void resume(ID id);
+
+    [[nodiscard]] bool contains(ID id) const;
+    [[nodiscard]] std::size_t size() const;
 
     void clear();
 
     template<typename T>
-    std::string every(const std::vector<double> &intervals, std::size_t count, T &&callback);
+    ID every(const std::vector<double> &intervals, std::size_t count, T &&callback);
 
     template<typename T>
-    std::string every(const std::vector<double> &intervals, T &&callback);
+    ID every(const std::vector<double> &intervals, T &&callback);
 
     template<typename T>
-    std::string every(double interval, std::size_t count, T &&callback);
+    ID every(double interval, std::size_t count, T &&callback);
 
     template<typename T>
-    std::string every(double interval, T &&callback);
+    ID every(double interval, T &&callback);
 
     template<typename T>
-    std::string until(const std::vector<double> &intervals, std::size_t count, T &&callback);
+    ID until(const std::vector<double> &intervals, std::size_t count, T &&callback);
 
     template<typename T>
-    std::string until(const std::vector<double> &intervals, T &&callback);
+    ID until(const std::vector<double> &intervals, T &&callback);
 
     template<typename T>
-    std::string until(double interval, std::size_t count, T &&callback);
+    ID until(double interval, std::size_t count, T &&callback);
 
     template<typename T>
-    std::string until(double interval, T &&callback);
+    ID until(double interval, T &&callback);
 
     template<typename T>
-    std::string after(double interval, T &&callback);
+    ID after(double interval, T &&callback);
 
     template<typename T>
-    std::string during(double duration, T &&callback);
+    ID during(double duration, T &&callback);
 
     template<typename T, typename U>
-    std::string during(double duration, T &&callback, U &&after_callback);
+    ID during(double duration, T &&callback, U &&after_callback);
+
+    /// Start a script, it runs up to its first co_await before this returns
+    ID run(Script script);
 
 private:
-    std::unordered_map<std::string, Timer *> timers_;
+    friend class WaitAwaiter;
+    friend class NextFrameAwaiter;
+
+    template<typename T>
+        requires HasAstraTag<T>
+    friend class EventAwaiter;
+
+    enum class Kind_ : std::uint8_t { Every, Until, After, During, Script };
+
+    struct Timer_ {
+        Kind_ kind;
+        bool paused{false};
+        std::uint32_t epoch{0}; // bumped on every (re)schedule, stale wheel entries don't match
+        std::uint64_t deadline{0}; // tick
+        std::uint64_t remaining{0}; // ticks left when paused
+        std::size_t lane{0}; // index into during_lanes_ while running
+        double duration_left{0.0}; // during_lanes_ countdown while paused
+
+        std::vector<std::uint64_t> intervals{}; // ticks
+        std::optional<std::size_t> count{};
+
+        std::function<void()> callback{};
+        std::function<bool()> until_callback{};
+        std::function<void()> after_callback{};
+
+        std::coroutine_handle<> coroutine{};
+        bool script_on_wheel{false}; // waiting on a WaitAwaiter
+        bool script_ready{false}; // became ready while paused
+    };
+
+    // parallel arrays, one lane per running `during` timer
+    struct DuringLanes_ {
+        std::vector<ID> ids{};
+        std::vector<double> remaining{};
+        std::vector<std::function<void()>> callbacks{};
+        std::vector<std::function<void()>> after_callbacks{};
+    };
+
+    struct WheelEntry_ {
+        ID id;
+        std::uint32_t epoch;
+    };
+
+    static constexpr std::size_t WHEEL_LEVELS = 4;
+    static constexpr std::size_t WHEEL_BITS = 8;
+    static constexpr std::size_t WHEEL_SLOTS = 1 << WHEEL_BITS;
+    static constexpr double TICKS_PER_SECOND = 1000.0;
+
+    SlotMap<Timer_> timers_{};
+    std::array<std::array<std::vector<WheelEntry_>, WHEEL_SLOTS>, WHEEL_LEVELS> wheel_{};
+    std::vector<WheelEntry_> due_{};
+    std::vector<WheelEntry_> immediate_{}; // already due when scheduled, fire on the next update however short it is
+
+    DuringLanes_ during_lanes_{};
+    std::vector<ID> during_snapshot_{};
+    std::vector<ID> during_expired_{};
+
+    std::vector<ID> ready_scripts_{};
+
+    std::uint64_t now_{0};
+    double tick_carry_{0.0};
+
+    ID every_(const std::vector<double> &intervals, std::optional<std::size_t> count, std::function<void()> callback);
+    ID until_(const std::vector<double> &intervals, std::optional<std::size_t> count, std::function<bool()> callback);
+    ID after_(double interval, std::function<void()> callback);
+    ID during_(double duration, std::function<void()> callback, std::function<void()> after_callback);
+
+    static std::uint64_t to_ticks_(double seconds);
+    static std::vector<std::uint64_t> to_ticks_(const std::vector<double> &intervals);
+    static std::uint64_t next_interval_(const Timer_ &timer);
 
-    std::string
-    every_(const std::vector<double> &intervals, std::optional<std::size_t> count, std::function<void()> callback);
+    void schedule_(ID id, Timer_ &timer);
+    void place_(const WheelEntry_ &entry, std::uint64_t deadline);
+    void cascade_(std::size_t level);
+    void advance_tick_();
 
-    std::string
-    until_(const std::vector<double> &intervals, std::optional<std::size_t> count, std::function<bool()> callback);
+    void fire_(const WheelEntry_ &entry);
 
-    std::string after_(double interval, std::function<void()> callback);
+    void add_during_lane_(ID id, Timer_ &timer, double remaining);
+    void remove_during_lane_(std::size_t lane);
+    std::optional<std::size_t> during_lane_(ID id) const;
+    void update_during_(double dt);
 
-    std::string during_(double duration, std::function<void()> callback, std::function<void()> after_callback);
+    void wait_script_(ID id, double seconds);
+    void ready_script_(ID id);
+    void resume_script_(ID id);
+    void update_scripts_(std::vector<ID> &ready);
+    void adopt_scripts_();
 
     void update_(double dt);
 
@@ -132,56 +191,56 @@ private:
 } // namespace astra
 
 template<typename T>
-std::string astra::TimerMgr::every(const std::vector<double> &intervals, std::size_t count, T &&callback) {
+astra::TimerMgr::ID astra::TimerMgr::every(const std::vector<double> &intervals, std::size_t count, T &&callback) {
     return every_(intervals, count, std::forward<T>(callback));
 }
 
 template<typename T>
-std::string astra::TimerMgr::every(const std::vector<double> &intervals, T &&callback) {
+astra::TimerMgr::ID astra::TimerMgr::every(const std::vector<double> &intervals, T &&callback) {
     return every_(intervals, std::nullopt, std::forward<T>(callback));
 }
 
 template<typename T>
-std::string astra::TimerMgr::every(double interval, std::size_t count, T &&callback) {
+astra::TimerMgr::ID astra::TimerMgr::every(double interval, std::size_t count, T &&callback) {
     return every_(std::vector{interval}, count, std::forward<T>(callback));
 }
 
 template<typename T>
-std::string astra::TimerMgr::every(double interval, T &&callback) {
+astra::TimerMgr::ID astra::TimerMgr::every(double interval, T &&callback) {
     return every_(std::vector{interval}, std::nullopt, std::forward<T>(callback));
 }
 
 template<typename T>
-std::string astra::TimerMgr::until(const std::vector<double> &intervals, std::size_t count, T &&callback) {
+astra::TimerMgr::ID astra::TimerMgr::until(const std::vector<double> &intervals, std::size_t count, T &&callback) {
     return until_(intervals, count, std::forward<T>(callback));
 }
 
 template<typename T>
-std::string astra::TimerMgr::until(const std::vector<double> &intervals, T &&callback) {
+astra::TimerMgr::ID astra::TimerMgr::until(const std::vector<double> &intervals, T &&callback) {
     return until_(intervals, std::nullopt, std::forward<T>(callback));
 }
 
 template<typename T>
-std::string astra::TimerMgr::until(double interval, std::size_t count, T &&callback) {
+astra::TimerMgr::ID astra::TimerMgr::until(double interval, std::size_t count, T &&callback) {
     return until_(std::vector{interval}, count, std::forward<T>(callback));
 }
 
 template<typename T>
-std::string astra::TimerMgr::until(double interval, T &&callback) {
+astra::TimerMgr::ID astra::TimerMgr::until(double interval, T &&callback) {
     return until_(std::vector{interval}, std::nullopt, std::forward<T>(callback));
 }
 
 template<typename T>
-std::string astra::TimerMgr::after(double interval, T &&callback) {
+astra::TimerMgr::ID astra::TimerMgr::after(double interval, T &&callback) {
     return after_(interval, std::forward<T>(callback));
 }
 
 template<typename T>
-std::string astra::TimerMgr::during(double duration, T &&callback) {
+astra::TimerMgr::ID astra::TimerMgr::during(double duration, T &&callback) {
     return during_(duration, std::forward<T>(callback), nullptr);
 }
 
 template<typename T, typename U>
-std::string astra::TimerMgr::during(double duration, T &&callback, U &&after_callback) {
+astra::TimerMgr::ID astra::TimerMgr::during(double duration, T &&callback, U &&after_callback) {
     return during_(duration, std::forward<T>(callback), std::forward<U>(after_callback));
 }
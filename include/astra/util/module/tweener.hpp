@@ -0,0 +1,155 @@
+#pragma once
+
+#include "astra/core/color.hpp"
+#include "astra/core/hermes.hpp"
+#include "astra/util/slot_map.hpp"
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace astra {
+enum class Ease : std::uint8_t {
+    Linear,
+    InQuad,
+    OutQuad,
+    InOutQuad,
+    InCubic,
+    OutCubic,
+    InOutCubic,
+    InQuart,
+    OutQuart,
+    InOutQuart,
+    InSine,
+    OutSine,
+    InOutSine,
+    InExpo,
+    OutExpo,
+    InOutExpo,
+    InBack,
+    OutBack,
+    InOutBack,
+    Count,
+};
+
+/// Evaluate an easing curve at t in [0, 1], every curve maps 0 to 0 and 1 to 1
+float ease(Ease e, float t);
+
+/* Animates plain values toward a target over a duration
+ *
+ * Active tweens are grouped by easing curve and width (1, 2 or 4 floats) and stored as parallel arrays. Each frame is
+ * one pass per group, with the curve and width known at compile time, that advances progress, evaluates the curve and
+ * writes the result, so there's no per-tween dispatch and the per-tween data is a few dozen contiguous bytes. Targets
+ * are written through pointers and must outlive the tween (or be cancelled first). RGB targets are animated in float
+ * shadows and rounded back every frame.
+ *
+ * Completion works like the after-callback of TimerMgr::during: it's called once, after the final value has been
+ * written, and not at all if the tween is cancelled. A duration <= 0 writes the final value and calls the
+ * after-callback before tween() returns, with NULL_ID.
+ */
+class Tweener {
+public:
+    using ID = std::uint64_t; // SlotMap key
+
+    static constexpr ID NULL_ID = 0;
+
+    Tweener();
+    ~Tweener();
+
+    Tweener(const Tweener &other) = delete;
+    Tweener &operator=(const Tweener &other) = delete;
+
+    Tweener(Tweener &&other) noexcept = delete;
+    Tweener &operator=(Tweener &&other) noexcept = delete;
+
+    ID tween(
+            float &target,
+            float to,
+            double duration,
+            Ease ease = Ease::Linear,
+            std::function<void()> after_callback = nullptr);
+
+    ID tween(
+            glm::vec2 &target,
+            glm::vec2 to,
+            double duration,
+            Ease ease = Ease::Linear,
+            std::function<void()> after_callback = nullptr);
+
+    ID tween(
+            glm::vec4 &target,
+            glm::vec4 to,
+            double duration,
+            Ease ease = Ease::Linear,
+            std::function<void()> after_callback = nullptr);
+
+    ID tween(
+            RGB &target,
+            const RGB &to,
+            double duration,
+            Ease ease = Ease::Linear,
+            std::function<void()> after_callback = nullptr);
+
+    /// Leaves the target wherever it is, doesn't call the after-callback
+    void cancel(ID id);
+
+    [[nodiscard]] bool contains(ID id) const;
+    [[nodiscard]] std::size_t size() const;
+
+    void clear();
+
+private:
+    static constexpr auto EASE_COUNT = static_cast<std::size_t>(Ease::Count);
+    static constexpr std::array<std::size_t, 3> WIDTHS{1, 2, 4};
+
+    // parallel arrays, one lane per tween
+    struct Lanes_ {
+        std::vector<ID> ids{};
+        std::vector<float> progress{}; // 0 to 1
+        std::vector<float> rate{}; // 1 / duration
+        std::vector<float> from{}; // width floats per lane
+        std::vector<float> delta{}; // width floats per lane
+        std::vector<float *> targets{}; // width contiguous floats
+        std::vector<std::function<void()>> after_callbacks{};
+    };
+
+    struct Record_ {
+        Ease ease;
+        std::size_t width_class;
+        std::size_t lane;
+        RGB *color_target{nullptr};
+        std::unique_ptr<glm::vec4> color_shadow{}; // stable address for the lane's target pointer
+        std::size_t color_index{0}; // position in color_tweens_
+    };
+
+    SlotMap<Record_> records_{};
+    std::array<std::array<Lanes_, WIDTHS.size()>, EASE_COUNT> lanes_{};
+    std::vector<ID> color_tweens_{};
+
+    std::vector<ID> finished_{};
+    std::vector<std::function<void()>> finished_callbacks_{};
+
+    ID add_(float *target,
+            std::span<const float> from,
+            std::span<const float> to,
+            double duration,
+            Ease ease,
+            std::function<void()> after_callback);
+
+    void remove_lane_(const Record_ &record);
+    void remove_color_(const Record_ &record);
+    void write_colors_();
+    void update_(float dt);
+
+    std::optional<Hermes::ID> hermes_id_;
+    void register_callbacks_();
+    void unregister_callbacks_();
+};
+} // namespace astra
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <span>
+
+/* Seedable gradient and value noise
+ *
+ *   const auto h = astra::noise::sample(p, {.kind = astra::noise::Kind::Simplex, .frequency = 0.01f, .octaves = 5});
+ *
+ *   std::vector<float> heights(256 * 256);
+ *   astra::noise::sample_grid({256, 256}, {0, 0}, {1, 1}, heights, params);
+ *
+ * Lattice points are hashed instead of looked up in a permutation table, so a seed costs nothing to switch and the
+ * batch functions are straight-line float and integer math over arrays that the compiler vectorizes. All kinds return
+ * roughly [-1, 1], fBm included (octaves are normalized by their total amplitude).
+ */
+
+namespace astra::noise {
+enum class Kind {
+    Value,
+    Perlin,
+    Simplex,
+};
+
+/// Seed derived from astra::rng's stream key, so noise replays along with a logged rng seed
+std::uint32_t default_seed();
+
+struct Params {
+    Kind kind{Kind::Perlin};
+    std::uint32_t seed{default_seed()};
+    float frequency{1.0f};
+
+    // fBm, a single octave is plain noise
+    int octaves{1};
+    float lacunarity{2.0f};
+    float gain{0.5f};
+};
+
+float value(glm::vec2 p, std::uint32_t seed);
+float value(glm::vec3 p, std::uint32_t seed);
+float perlin(glm::vec2 p, std::uint32_t seed);
+float perlin(glm::vec3 p, std::uint32_t seed);
+float simplex(glm::vec2 p, std::uint32_t seed);
+float simplex(glm::vec3 p, std::uint32_t seed);
+
+float sample(glm::vec2 p, const Params &params = {});
+float sample(glm::vec3 p, const Params &params = {});
+
+// out must be at least as long as points
+void sample(std::span<const glm::vec2> points, std::span<float> out, const Params &params = {});
+void sample(std::span<const glm::vec3> points, std::span<float> out, const Params &params = {});
+
+/// Row-major size.x * size.y samples at origin + step * (x, y), out must hold all of them
+void sample_grid(glm::ivec2 size, glm::vec2 origin, glm::vec2 step, std::span<float> out, const Params &params = {});
+} // namespace astra::noise
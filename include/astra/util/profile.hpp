@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/* Scoped CPU profiling zones
+ *
+ * ASTRA_PROFILE_SCOPE("name") times the rest of the enclosing scope. Each thread writes finished zones into its own
+ * ring (no locks, the newest PROFILE_RING_SIZE zones are kept), so the cost is two clock reads and a few stores.
+ * Names must be string literals or otherwise live forever, only the pointer is kept. When a thread exits its ring is
+ * handed to the next thread that starts recording, until then its zones still show up in collect().
+ *
+ * Built with the ASTRA_PROFILE CMake option, without it the macros are empty and collect() returns nothing.
+ */
+
+namespace astra::profile {
+constexpr std::size_t PROFILE_RING_SIZE = 1 << 14;
+
+struct Zone {
+    const char *name;
+    std::int64_t begin_ns; // astra::time_ns()
+    std::int64_t end_ns;
+    std::uint32_t depth; // nesting level on its thread, 0 for outermost
+};
+
+struct ThreadZones {
+    std::uint32_t thread_index; // in order of each thread's first zone, the Chrome trace tid
+    std::string thread_name;
+    std::vector<Zone> zones; // oldest first
+};
+
+/// Shows up as the thread's name in traces, otherwise it's "thread N"
+void set_thread_name(std::string name);
+
+/// Copy out what's in every thread's ring, safe to call while other threads are recording
+std::vector<ThreadZones> collect();
+
+/// Chrome trace event JSON, open it in chrome://tracing or ui.perfetto.dev
+bool export_chrome_trace(const std::filesystem::path &path);
+bool export_chrome_trace(const std::filesystem::path &path, std::span<const ThreadZones> threads);
+
+namespace detail {
+struct ThreadRing {
+    // Written only by the owning thread, atomics so collect() can read them from another one without a race
+    struct Slot {
+        std::atomic<const char *> name{nullptr};
+        std::atomic<std::int64_t> begin_ns{0};
+        std::atomic<std::int64_t> end_ns{0};
+        std::atomic<std::uint32_t> depth{0};
+    };
+
+    std::unique_ptr<Slot[]> slots{new Slot[PROFILE_RING_SIZE]};
+    std::atomic<std::uint64_t> written{0};
+    std::uint32_t depth{0};
+    std::uint32_t thread_index{0};
+    std::string thread_name; // guarded by the registry's mutex
+};
+
+ThreadRing &thread_ring();
+
+/// Same clock as astra::time_ns()
+std::int64_t now_ns();
+
+class Scope {
+public:
+    explicit Scope(const char *name)
+        : ring_(thread_ring()),
+          name_(name),
+          depth_(ring_.depth++),
+          begin_ns_(now_ns()) {}
+
+    ~Scope() {
+        const auto end_ns = now_ns();
+        const auto n = ring_.written.load(std::memory_order_relaxed);
+        auto &slot = ring_.slots[n & (PROFILE_RING_SIZE - 1)];
+        slot.name.store(name_, std::memory_order_relaxed);
+        slot.begin_ns.store(begin_ns_, std::memory_order_relaxed);
+        slot.end_ns.store(end_ns, std::memory_order_relaxed);
+        slot.depth.store(depth_, std::memory_order_relaxed);
+        ring_.written.store(n + 1, std::memory_order_release);
+        --ring_.depth;
+    }
+
+    Scope(const Scope &other) = delete;
+    Scope &operator=(const Scope &other) = delete;
+
+    Scope(Scope &&other) noexcept = delete;
+    Scope &operator=(Scope &&other) noexcept = delete;
+
+private:
+    ThreadRing &ring_;
+    const char *name_;
+    std::uint32_t depth_;
+    std::int64_t begin_ns_;
+};
+} // namespace detail
+} // namespace astra::profile
+
+#define ASTRA_PROFILE_CONCAT_INNER_(a, b) a##b
+#define ASTRA_PROFILE_CONCAT_(a, b) ASTRA_PROFILE_CONCAT_INNER_(a, b)
+
+#if defined(ASTRA_PROFILE_ENABLED)
+#define ASTRA_PROFILE_SCOPE(name)                                                                                      \
+    const astra::profile::detail::Scope ASTRA_PROFILE_CONCAT_(astra_profile_scope_, __LINE__) { name }
+#define ASTRA_PROFILE_FUNCTION() ASTRA_PROFILE_SCOPE(__func__)
+#else
+#define ASTRA_PROFILE_SCOPE(name) static_cast<void>(0)
+#define ASTRA_PROFILE_FUNCTION() static_cast<void>(0)
+#endif
@@ -5,9 +5,12 @@
 #include <glm/vec2.hpp>
 #include <pcg_random.hpp>
 
+#include <array>
 #include <cstdint>
+#include <limits>
 #include <numbers>
 #include <random>
+#include <span>
 #include <string>
 
 namespace astra::rng {
@@ -23,6 +26,10 @@ void reseed();
 void seed128(std::uint64_t seed_hi, std::uint64_t seed_lo, std::uint64_t stream_hi = 0, std::uint64_t stream_lo = 0);
 void log_seed();
 
+/// Key shared by every Stream, derived from the seed given to reseed()/seed128() (or the first thread's seed)
+std::uint64_t stream_key();
+void set_stream_key(std::uint64_t key);
+
 /***********
  * INTEGERS
  */
@@ -142,4 +149,81 @@ T get() {
 std::string base58(std::size_t length);
 
 glm::vec2 area_circle(glm::vec2 center, double radius);
+
+/*******
+ * BULK
+ */
+
+/* Eight xoshiro256++ generators stepped in lockstep
+ *
+ * Each state word is its own array, so a step is element-wise integer math over all lanes that the compiler turns into
+ * vector instructions (two AVX2 registers per word), and one step yields LANES outputs. Seeded from the thread's
+ * pcg64, so seed128() makes the bulk functions reproducible as well.
+ */
+class BulkGenerator {
+public:
+    static constexpr std::size_t LANES = 8;
+
+    void seed(pcg64 &source);
+
+    void fill(std::span<std::uint64_t> out);
+
+private:
+    alignas(64) std::array<std::uint64_t, LANES> s0_{};
+    alignas(64) std::array<std::uint64_t, LANES> s1_{};
+    alignas(64) std::array<std::uint64_t, LANES> s2_{};
+    alignas(64) std::array<std::uint64_t, LANES> s3_{};
+
+    void step_(std::uint64_t *out);
+};
+
+BulkGenerator &bulk_generator();
+
+// Same ranges as the matching get() overloads, bounds are swapped if low > high
+void fill(std::span<float> out, float low, float high);
+void fill(std::span<double> out, double low, double high);
+void fill(std::span<std::int32_t> out, std::int32_t low, std::int32_t high);
+void fill(std::span<std::uint32_t> out, std::uint32_t low, std::uint32_t high);
+void fill(std::span<bool> out, double chance = 0.5);
+
+void fill_unit_vectors(std::span<glm::vec2> out);
+void fill_area_circle(std::span<glm::vec2> out, glm::vec2 center, double radius);
+
+/**********
+ * STREAMS
+ */
+
+/* Counter-based generator (Philox4x32-10) addressed by (key, entity, frame)
+ *
+ * Output is a pure function of the key, the entity, the frame and how many values have been drawn, there's no shared
+ * state, so a job that builds Stream(entity_id, frame) gets the same numbers on any thread and in any order. Use these
+ * instead of generator() for anything that runs in parallel and still has to replay from a logged seed.
+ *
+ * Satisfies UniformRandomBitGenerator, so it also works with the std distributions. Each (entity, frame) pair has
+ * 2^32 blocks of four values before it wraps.
+ */
+class Stream {
+public:
+    using result_type = std::uint32_t;
+
+    Stream(std::uint64_t entity, std::uint32_t frame);
+    Stream(std::uint64_t key, std::uint64_t entity, std::uint32_t frame);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()();
+    void discard(std::uint64_t n);
+
+    /// In [0, 1), from the top 24 bits of the next value
+    float unit();
+
+private:
+    std::array<std::uint32_t, 2> key_;
+    std::array<std::uint32_t, 4> counter_;
+    std::array<std::uint32_t, 4> block_{};
+    std::size_t next_{4}; // position in block_, 4 means it's used up
+
+    void generate_block_();
+};
 } // namespace astra::rng
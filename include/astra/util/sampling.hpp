@@ -0,0 +1,25 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+
+#include <span>
+#include <vector>
+
+/* Uniform random points in shapes, written in batches
+ *
+ * Everything draws from astra::rng's bulk generator, and is uniform by area (a disc doesn't bunch up in the middle).
+ * Discs and rings get their directions by rejection from the unit square instead of sin/cos.
+ */
+
+namespace astra::rng {
+void fill_disc(std::span<glm::vec2> out, glm::vec2 center, float radius);
+void fill_ring(std::span<glm::vec2> out, glm::vec2 center, float inner_radius, float outer_radius);
+void fill_rect(std::span<glm::vec2> out, glm::vec2 min, glm::vec2 max);
+void fill_triangle(std::span<glm::vec2> out, glm::vec2 a, glm::vec2 b, glm::vec2 c);
+
+/// Any simple polygon (convex or not, either winding), it's ear-clipped once per call
+void fill_polygon(std::span<glm::vec2> out, std::span<const glm::vec2> vertices);
+
+/// Points in [min, max] no closer than min_distance to each other (Bridson's algorithm)
+std::vector<glm::vec2> poisson_disc(glm::vec2 min, glm::vec2 max, float min_distance, int attempts = 30);
+} // namespace astra::rng
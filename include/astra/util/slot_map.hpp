@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace astra {
+/* Dense storage addressed through stable 64-bit generational keys
+ *
+ * Values live contiguously (erase swaps the last value into the hole), so iterating is a linear walk. A key is
+ * (generation << 32 | slot index); erasing bumps the slot's generation, so stale keys are rejected instead of
+ * aliasing whatever reuses the slot. Key 0 is never handed out and can be used as a null key.
+ */
+template<typename T>
+class SlotMap {
+public:
+    using Key = std::uint64_t;
+
+    static constexpr Key NULL_KEY = 0;
+
+    template<typename... Args>
+    Key emplace(Args &&...args);
+
+    Key insert(T value);
+
+    /// Returns false if the key was stale
+    bool erase(Key key);
+
+    void clear();
+
+    [[nodiscard]] T *get(Key key);
+    [[nodiscard]] const T *get(Key key) const;
+
+    [[nodiscard]] bool contains(Key key) const;
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] bool empty() const;
+
+    /// Values in storage order, which changes whenever something is erased
+    [[nodiscard]] std::span<T> values();
+    [[nodiscard]] std::span<const T> values() const;
+
+    /// The key of the value at a position in values()
+    [[nodiscard]] Key key_at(std::size_t dense_index) const;
+
+private:
+    static constexpr std::uint32_t FREE_LIST_END = std::numeric_limits<std::uint32_t>::max();
+
+    struct Slot_ {
+        std::uint32_t generation{1};
+        std::uint32_t index{0}; // into values_ while live, next free slot while free
+    };
+
+    std::vector<Slot_> slots_{};
+    std::vector<T> values_{};
+    std::vector<std::uint32_t> value_slots_{}; // slot of each value, for swap-erase
+    std::uint32_t free_head_{FREE_LIST_END};
+
+    static constexpr Key make_key_(const std::uint32_t generation, const std::uint32_t slot) {
+        return static_cast<Key>(generation) << 32 | slot;
+    }
+
+    static constexpr std::uint32_t key_slot_(const Key key) {
+        return static_cast<std::uint32_t>(key);
+    }
+
+    static constexpr std::uint32_t key_generation_(const Key key) {
+        return static_cast<std::uint32_t>(key >> 32);
+    }
+
+    const Slot_ *live_slot_(Key key) const;
+};
+} // namespace astra
+
+template<typename T>
+template<typename... Args>
+typename astra::SlotMap<T>::Key astra::SlotMap<T>::emplace(Args &&...args) {
+    std::uint32_t slot;
+    if (free_head_ != FREE_LIST_END) {
+        slot = free_head_;
+        free_head_ = slots_[slot].index;
+    } else {
+        slot = static_cast<std::uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    values_.emplace_back(std::forward<Args>(args)...);
+    value_slots_.push_back(slot);
+    slots_[slot].index = static_cast<std::uint32_t>(values_.size() - 1);
+
+    return make_key_(slots_[slot].generation, slot);
+}
+
+template<typename T>
+typename astra::SlotMap<T>::Key astra::SlotMap<T>::insert(T value) {
+    return emplace(std::move(value));
+}
+
+template<typename T>
+bool astra::SlotMap<T>::erase(const Key key) {
+    if (!live_slot_(key)) return false;
+
+    const auto slot = key_slot_(key);
+    const auto index = slots_[slot].index;
+
+    if (index != values_.size() - 1) {
+        values_[index] = std::move(values_.back());
+        value_slots_[index] = value_slots_.back();
+        slots_[value_slots_[index]].index = index;
+    }
+    values_.pop_back();
+    value_slots_.pop_back();
+
+    // skip 0 on wrap so a recycled slot can never produce the null key
+    if (++slots_[slot].generation == 0) slots_[slot].generation = 1;
+    slots_[slot].index = free_head_;
+    free_head_ = slot;
+
+    return true;
+}
+
+template<typename T>
+void astra::SlotMap<T>::clear() {
+    for (const auto slot: value_slots_) {
+        if (++slots_[slot].generation == 0) slots_[slot].generation = 1;
+        slots_[slot].index = free_head_;
+        free_head_ = slot;
+    }
+    values_.clear();
+    value_slots_.clear();
+}
+
+template<typename T>
+T *astra::SlotMap<T>::get(const Key key) {
+    const auto slot = live_slot_(key);
+    return slot ? &values_[slot->index] : nullptr;
+}
+
+template<typename T>
+const T *astra::SlotMap<T>::get(const Key key) const {
+    const auto slot = live_slot_(key);
+    return slot ? &values_[slot->index] : nullptr;
+}
+
+template<typename T>
+bool astra::SlotMap<T>::contains(const Key key) const {
+    return live_slot_(key) != nullptr;
+}
+
+template<typename T>
+std::size_t astra::SlotMap<T>::size() const {
+    return values_.size();
+}
+
+template<typename T>
+bool astra::SlotMap<T>::empty() const {
+    return values_.empty();
+}
+
+template<typename T>
+std::span<T> astra::SlotMap<T>::values() {
+    return values_;
+}
+
+template<typename T>
+std::span<const T> astra::SlotMap<T>::values() const {
+    return values_;
+}
+
+template<typename T>
+typename astra::SlotMap<T>::Key astra::SlotMap<T>::key_at(const std::size_t dense_index) const {
+    const auto slot = value_slots_[dense_index];
+    return make_key_(slots_[slot].generation, slot);
+}
+
+template<typename T>
+const typename astra::SlotMap<T>::Slot_ *astra::SlotMap<T>::live_slot_(const Key key) const {
+    const auto slot = key_slot_(key);
+    if (slot >= slots_.size()) return nullptr;
+
+    const auto &s = slots_[slot];
+    if (s.generation != key_generation_(key)) return nullptr;
+
+    // a free slot's generation was already bumped, so a matching generation means it's live
+    return &s;
+}
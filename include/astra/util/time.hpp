@@ -37,8 +37,14 @@ public:
 
     std::vector<double> fps_history() const;
 
+    /// Frame time in seconds at quantile q (0.99 for p99) over the last full second, the current one until there is one
+    double frame_time_quantile(double q) const;
+    void reset_frame_times();
+
 private:
     EMA averager_;
+    DDSketch frame_times_; // the second in progress
+    DDSketch last_frame_times_; // the one before it
     std::int64_t last_alpha_update_;
     std::deque<std::int64_t> timestamps;
 };
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "astra/util/io.hpp"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+/* APAK pack archive
+ *
+ * Written offline by the `apak` tool, mapped once when mounted. Layout (little-endian):
+ *
+ *   ApakHeader
+ *   ApakEntry[header.entry_count]      sorted by (hash, name) so lookups are a binary search
+ *   names                              entry names, not null terminated, referenced by offset/size
+ *   entry data, each starting on an APAK_DATA_ALIGNMENT boundary
+ *
+ * Entry names are normalized generic paths relative to the packed directory, hashed with fnv1a_64.
+ */
+
+namespace astra {
+constexpr std::array<char, 4> APAK_MAGIC{'A', 'P', 'A', 'K'};
+constexpr std::uint32_t APAK_VERSION = 1;
+constexpr std::uint64_t APAK_DATA_ALIGNMENT = 16;
+
+enum class ApakCompression : std::uint32_t {
+    None = 0,
+    Lz4 = 1,
+};
+
+struct ApakHeader {
+    std::array<char, 4> magic;
+    std::uint32_t version;
+    std::uint32_t entry_count;
+    std::uint32_t names_size;
+    std::uint64_t names_offset;
+};
+static_assert(sizeof(ApakHeader) == 24);
+
+struct ApakEntry {
+    std::uint64_t hash;
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint64_t uncompressed_size;
+    std::uint32_t name_offset;
+    std::uint32_t name_size;
+    ApakCompression compression;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(ApakEntry) == 48);
+
+/// Contents of a file read through the VFS, either a view into a mounted pack (which stays mapped while the view is
+/// alive, even if unmounted) or owned bytes
+class VfsFile {
+    friend class Vfs;
+    friend class IoService;
+
+public:
+    VfsFile(const VfsFile &other) = delete;
+    VfsFile &operator=(const VfsFile &other) = delete;
+
+    VfsFile(VfsFile &&other) noexcept = default;
+    VfsFile &operator=(VfsFile &&other) noexcept = default;
+
+    [[nodiscard]] std::span<const std::byte> bytes() const;
+    [[nodiscard]] std::string_view view() const;
+
+    /// A copy of the contents, on Windows without the '\r's a text mode stream would have dropped
+    [[nodiscard]] std::string text() const;
+
+private:
+    std::variant<std::shared_ptr<const void>, MappedFile, std::vector<std::byte>> storage_; // the pack for a view
+    std::span<const std::byte> bytes_;
+
+    VfsFile(std::shared_ptr<const void> pack, std::span<const std::byte> view);
+    explicit VfsFile(MappedFile file);
+    explicit VfsFile(std::vector<std::byte> data);
+};
+
+/* Mounts are searched newest first, a path that no mount resolves is read straight from disk so code that
+ * doesn't care about packs keeps working. Everything is safe from any thread: lookups share a lock, mounting and
+ * unmounting take it exclusively, and files are read or decompressed after it's released.
+ */
+class Vfs {
+public:
+    bool mount_dir(const std::filesystem::path &dir, std::string_view mount_point = "");
+    bool mount_pack(const std::filesystem::path &path, std::string_view mount_point = "");
+    void unmount_all();
+
+    [[nodiscard]] bool exists(const std::filesystem::path &path) const;
+    [[nodiscard]] std::optional<VfsFile> read(const std::filesystem::path &path) const;
+
+    /// Files on disk read() would try for path, in order, without touching the disk. Empty when a pack serves it
+    /// first. If none of them exists, read() finds it in a pack or fails.
+    [[nodiscard]] std::vector<std::filesystem::path> disk_candidates(const std::filesystem::path &path) const;
+
+private:
+    struct DirMount_ {
+        std::string mount_point;
+        std::filesystem::path root;
+    };
+
+    struct PackMount_ {
+        std::string mount_point;
+        std::filesystem::path path;
+        MappedFile file;
+        std::span<const ApakEntry> entries;
+        std::string_view names;
+
+        [[nodiscard]] const ApakEntry *find(std::string_view name) const;
+    };
+
+    struct PackHit_ {
+        std::shared_ptr<const PackMount_> pack;
+        const ApakEntry *entry;
+    };
+
+    // nothing, a file on disk, or a pack entry
+    using Resolved_ = std::variant<std::monostate, std::filesystem::path, PackHit_>;
+
+    mutable std::shared_mutex mutex_;
+    std::vector<std::variant<DirMount_, std::shared_ptr<const PackMount_>>> mounts_; // guarded by the mutex
+
+    // Calls on_dir(full path) or on_pack(PackHit_) for each mount under which norm exists or may exist, newest first,
+    // until one returns true. The mutex is held throughout.
+    template<typename OnDir, typename OnPack>
+    bool walk_mounts_(std::string_view norm, OnDir &&on_dir, OnPack &&on_pack) const;
+
+    [[nodiscard]] Resolved_ resolve_(const std::filesystem::path &path) const;
+    [[nodiscard]] static std::optional<VfsFile> read_pack_entry_(const PackHit_ &hit);
+};
+
+Vfs &vfs();
+
+/// Generic form relative to a mount root, nullopt if the path leaves it through ".."
+std::optional<std::string> normalize_vfs_path(const std::filesystem::path &path);
+} // namespace astra
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "astra/core/log.hpp"
+#include "gloo/counters.hpp"
 #include "gloo/gl.hpp"
+#include "gloo/state.hpp"
 
 #include <cstdint>
 #include <vector>
@@ -59,6 +61,7 @@ gloo::Buffer<T>::Buffer(std::size_t capacity, BufferFillDirection fill_direction
 template<typename T>
 gloo::Buffer<T>::~Buffer() {
     if (id != 0) {
+        state::forget_buffer(id);
         glDeleteBuffers(1, &id);
         ASTRA_LOG_TRACE("Deleted buffer (id={})", id);
     }
@@ -125,9 +128,11 @@ void gloo::Buffer<T>::sync() {
 
     switch (fill_direction_) {
     case BufferFillDirection::Forward:
+        GLOO_COUNT(bytes_uploaded, (data_pos_ - buf_pos_) * sizeof(T));
         glNamedBufferSubData(id, buf_pos_ * sizeof(T), (data_pos_ - buf_pos_) * sizeof(T), data_.data() + buf_pos_);
         break;
     case BufferFillDirection::Backward:
+        GLOO_COUNT(bytes_uploaded, (buf_pos_ - data_pos_) * sizeof(T));
         glNamedBufferSubData(id, data_pos_ * sizeof(T), (buf_pos_ - data_pos_) * sizeof(T), data_.data() + data_pos_);
         break;
     default: std::unreachable();
@@ -155,10 +160,10 @@ GLsizei gloo::Buffer<T>::size() const {
 
 template<typename T>
 void gloo::Buffer<T>::bind(const GLuint binding_index, const GLintptr offset, const GLsizei stride) const {
-    glBindVertexBuffer(binding_index, id, offset, stride);
+    state::bind_vertex_buffer(binding_index, id, offset, stride);
 }
 
 template<typename T>
 void gloo::Buffer<T>::unbind(GLuint binding_index) const {
-    glBindVertexBuffer(binding_index, 0, 0, 0);
+    state::bind_vertex_buffer(binding_index, 0, 0, 0);
 }
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+/* Per-frame counts of what the gloo wrappers sent to GL
+ *
+ * Built with the ASTRA_GL_COUNTERS CMake option, without it GLOO_COUNT is empty and every count stays 0. Only calls
+ * that go through gloo are seen, the ImGui backend and raw gl* calls aren't.
+ */
+
+namespace gloo {
+struct Counters {
+    std::uint64_t draw_calls{0};
+    std::uint64_t vertices{0};
+    std::uint64_t state_changes{0}; // program, vertex array, buffer and texture binds, caps, viewport
+    std::uint64_t elided_calls{0}; // state changes skipped by gloo::state because nothing would change
+    std::uint64_t uniform_uploads{0};
+    std::uint64_t bytes_uploaded{0}; // buffer data, textures aren't counted
+    std::uint64_t clears{0};
+};
+
+/// The frame in progress
+const Counters &frame_counters();
+
+/// The last finished frame, what a benchmark should check a budget against
+const Counters &last_frame_counters();
+
+/// Called by the mainloop right before the swap
+void end_frame_counters();
+
+namespace detail {
+Counters &current_counters();
+} // namespace detail
+} // namespace gloo
+
+#if defined(ASTRA_GL_COUNTERS_ENABLED)
+#define GLOO_COUNT(field, n) (gloo::detail::current_counters().field += static_cast<std::uint64_t>(n))
+#else
+#define GLOO_COUNT(field, n) static_cast<void>(0)
+#endif
@@ -1,8 +1,12 @@
 #pragma once
 
 #include "gloo/buffer.hpp"
+#include "gloo/counters.hpp"
 #include "gloo/gl.hpp"
+#include "gloo/gpu_timer.hpp"
 #include "gloo/init.hpp"
 #include "gloo/shader.hpp"
+#include "gloo/state.hpp"
+#include "gloo/texture.hpp"
 #include "gloo/vertex_array.hpp"
 #include "gloo/wrap.hpp"
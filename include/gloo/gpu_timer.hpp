@@ -0,0 +1,87 @@
+#pragma once
+
+#include "gloo/gl.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/* GPU time per named scope, from GL_TIMESTAMP queries
+ *
+ * Each frame writes its queries into one of FRAMES_IN_FLIGHT slots and reads back the slot it's about to reuse, so
+ * results are a few frames old but reading them never waits on the GPU. If a slot still isn't done when it comes
+ * around again its frame is dropped instead. Timestamps rather than GL_TIME_ELAPSED so scopes can nest.
+ *
+ * Names must be string literals or otherwise live forever, only the pointer is kept.
+ */
+
+namespace gloo {
+class GpuTimer {
+public:
+    static constexpr std::size_t FRAMES_IN_FLIGHT = 4;
+
+    struct Result {
+        const char *name;
+        std::uint32_t depth; // nesting level, 0 for outermost
+        double ms;
+    };
+
+    explicit GpuTimer(std::size_t max_scopes = 32);
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer &other) = delete;
+    GpuTimer &operator=(const GpuTimer &other) = delete;
+
+    GpuTimer(GpuTimer &&other) noexcept = delete;
+    GpuTimer &operator=(GpuTimer &&other) noexcept = delete;
+
+    /// Call once per frame before any scopes, picks up whatever finished frame is ready
+    void new_frame();
+
+    void begin(const char *name);
+    void end();
+
+    /// Scopes of the newest frame read back, in the order they began
+    [[nodiscard]] std::span<const Result> results() const;
+    [[nodiscard]] std::uint64_t dropped_frames() const;
+
+    class Scope {
+    public:
+        /// A null timer makes this a no-op, so call sites don't need to check
+        Scope(GpuTimer *timer, const char *name);
+        ~Scope();
+
+        Scope(const Scope &other) = delete;
+        Scope &operator=(const Scope &other) = delete;
+
+        Scope(Scope &&other) noexcept = delete;
+        Scope &operator=(Scope &&other) noexcept = delete;
+
+    private:
+        GpuTimer *timer_;
+    };
+
+private:
+    struct Scope_ {
+        const char *name;
+        std::uint32_t depth;
+    };
+
+    struct Frame_ {
+        std::vector<GLuint> queries; // begin at 2 * i, end at 2 * i + 1
+        std::vector<Scope_> scopes;
+        GLuint last{0}; // the most recently issued query, the last one to finish
+    };
+
+    std::size_t max_scopes_;
+    std::vector<Frame_> frames_;
+    std::size_t current_{0};
+    std::vector<std::size_t> open_{}; // scopes begun but not ended in the current frame
+
+    std::vector<Result> results_{};
+    std::uint64_t dropped_frames_{0};
+    bool warned_overflow_{false};
+
+    bool read_back_(const Frame_ &frame);
+};
+} // namespace gloo
@@ -85,6 +85,9 @@ private:
     std::unordered_set<std::string> bad_attrib_locations_{};
 
     std::optional<GLint> try_get_uniform_location_(const std::string &name);
+
+    template<typename F, typename... Args>
+    void upload_(const std::string &name, F &&f, Args &&...args);
 };
 
 enum class ShaderType {
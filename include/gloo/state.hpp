@@ -0,0 +1,35 @@
+#pragma once
+
+#include "gloo/gl.hpp"
+
+#include <glm/vec4.hpp>
+
+/* Remembers the GL state gloo last set and skips calls that wouldn't change it
+ *
+ * Only sees what goes through gloo. Anything that sets GL state directly must restore it afterward (the ImGui backend
+ * does) or call invalidate(), and the mainloop invalidates once per frame so a stray raw call can't stick for long.
+ * Skipped calls are counted as Counters::elided_calls.
+ */
+
+namespace gloo::state {
+void use_program(GLuint id);
+void bind_vertex_array(GLuint id);
+
+/// Vertex buffer bindings belong to the bound vertex array, switching arrays forgets them
+void bind_vertex_buffer(GLuint binding_index, GLuint buffer, GLintptr offset, GLsizei stride);
+void bind_texture_unit(GLuint unit, GLuint id);
+
+void set_enabled(GLenum cap, bool enabled); // GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST
+void blend_func(GLenum src, GLenum dst);
+void depth_func(GLenum func);
+void viewport(glm::ivec4 rect);
+
+/// Object names get reused, deleting one has to drop it from the cache
+void forget_program(GLuint id);
+void forget_vertex_array(GLuint id);
+void forget_buffer(GLuint id);
+void forget_texture(GLuint id);
+
+/// Next call of every kind goes to the driver
+void invalidate();
+} // namespace gloo::state
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "gloo/gl.hpp"
+
+#include <glm/vec2.hpp>
+
+#include <memory>
+
+namespace gloo {
+class Texture {
+    friend class TextureBuilder;
+
+    Texture(GLuint id, GLenum target, GLenum internal_format, glm::ivec2 size, GLsizei levels);
+
+public:
+    GLuint id{0};
+
+    ~Texture();
+
+    Texture(const Texture &other) = delete;
+    Texture &operator=(const Texture &other) = delete;
+
+    Texture(Texture &&other) noexcept;
+    Texture &operator=(Texture &&other) noexcept;
+
+    [[nodiscard]] GLenum target() const;
+    [[nodiscard]] GLenum internal_format() const;
+    [[nodiscard]] glm::ivec2 size() const;
+    [[nodiscard]] GLsizei levels() const;
+
+    void upload(GLint level, glm::ivec2 size, GLenum format, GLenum type, const void *pixels);
+    void upload_compressed(GLint level, glm::ivec2 size, GLsizei byte_size, const void *data);
+
+    void bind(GLuint unit) const;
+    void unbind(GLuint unit) const;
+
+private:
+    GLenum target_;
+    GLenum internal_format_;
+    glm::ivec2 size_;
+    GLsizei levels_;
+};
+
+class TextureBuilder {
+public:
+    explicit TextureBuilder(GLenum target = GL_TEXTURE_2D);
+    ~TextureBuilder();
+
+    TextureBuilder(const TextureBuilder &other) = delete;
+    TextureBuilder &operator=(const TextureBuilder &other) = delete;
+
+    TextureBuilder(TextureBuilder &&other) noexcept = delete;
+    TextureBuilder &operator=(TextureBuilder &&other) noexcept = delete;
+
+    TextureBuilder &storage(GLenum internal_format, glm::ivec2 size, GLsizei levels = 1);
+    TextureBuilder &filter(GLenum min_filter, GLenum mag_filter);
+    TextureBuilder &wrap(GLenum wrap_s, GLenum wrap_t);
+
+    std::unique_ptr<Texture> build();
+
+private:
+    GLuint id_;
+    GLenum target_;
+    GLenum internal_format_{GL_RGBA8};
+    glm::ivec2 size_{0, 0};
+    GLsizei levels_{1};
+};
+} // namespace gloo
@@ -5,4 +5,8 @@
 
 namespace gloo {
 void clear(const astra::Color &color, GLenum clear_bits);
+
+void draw_arrays(GLenum mode, GLint first, GLsizei count);
+void draw_arrays_instanced(GLenum mode, GLint first, GLsizei count, GLsizei instance_count);
+void draw_elements(GLenum mode, GLsizei count, GLenum type, const void *indices);
 } // namespace gloo
@@ -0,0 +1,301 @@
+#include "astra/core/binlog.hpp"
+
+#include "astra/core/log.hpp"
+#include "astra/util/time.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Each thread fills its own chunk with no shared lock, full chunks (and on errors, partial ones) are handed to a
+ * writer thread that does all the file I/O. Site definitions go through the shared state instead, the writer always
+ * writes the pending ones before the chunks it picked up in the same batch, so a record never precedes its site.
+ * Records from different threads end up interleaved by chunk, alogdump puts them back in time order.
+ */
+
+constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+constexpr std::size_t MAX_FREE_CHUNKS = 16;
+
+struct BinlogChunk {
+    std::vector<std::byte> data;
+    std::size_t used{0};
+    std::uint32_t generation{0};
+};
+
+struct ThreadBuffer {
+    std::mutex mutex; // only ever contended by flush() and close() taking a partial chunk
+    std::unique_ptr<BinlogChunk> chunk;
+};
+
+struct BinlogState {
+    std::atomic<bool> open{false};
+    std::atomic<std::uint32_t> generation{1};
+    std::atomic<std::int64_t> start_ns{0};
+
+    // everything below is guarded by the mutex, except the file which only the writer touches while it runs
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable flushed;
+
+    std::vector<std::shared_ptr<ThreadBuffer>> threads; // live threads, one that exits hands off its chunk and leaves
+    std::vector<std::byte> definitions;
+    std::vector<std::unique_ptr<BinlogChunk>> full;
+    std::vector<std::unique_ptr<BinlogChunk>> free;
+    std::uint32_t next_id{1};
+    std::uint64_t flush_requested{0};
+    std::uint64_t flush_done{0};
+    bool stopping{false};
+
+    std::ofstream ofs;
+    std::thread writer;
+};
+
+BinlogState &state() {
+    static BinlogState s;
+    return s;
+}
+
+// Caller holds the state mutex
+void hand_off(BinlogState &s, std::unique_ptr<BinlogChunk> &chunk) {
+    if (chunk && chunk->used > 0) s.full.push_back(std::move(chunk));
+    chunk.reset();
+}
+
+// Owned by a thread_local, so the list only holds threads that can still write
+struct ThreadBufferHandle {
+    std::shared_ptr<ThreadBuffer> buffer{std::make_shared<ThreadBuffer>()};
+
+    ThreadBufferHandle() {
+        auto &s = state();
+        std::lock_guard lock(s.mutex);
+        s.threads.push_back(buffer);
+    }
+
+    ~ThreadBufferHandle() {
+        auto &s = state();
+        std::lock_guard thread_lock(buffer->mutex);
+        std::lock_guard lock(s.mutex);
+        hand_off(s, buffer->chunk);
+        s.wake.notify_one();
+        std::erase(s.threads, buffer);
+    }
+
+    ThreadBufferHandle(const ThreadBufferHandle &other) = delete;
+    ThreadBufferHandle &operator=(const ThreadBufferHandle &other) = delete;
+};
+
+ThreadBuffer &thread_buffer() {
+    thread_local const ThreadBufferHandle handle;
+    return *handle.buffer;
+}
+
+// Caller holds the state mutex
+std::unique_ptr<BinlogChunk> take_chunk(BinlogState &s, const std::size_t min_size, const std::uint32_t generation) {
+    std::unique_ptr<BinlogChunk> chunk;
+    if (min_size <= CHUNK_SIZE && !s.free.empty()) {
+        chunk = std::move(s.free.back());
+        s.free.pop_back();
+    } else {
+        chunk = std::make_unique<BinlogChunk>();
+        chunk->data.resize(std::max(min_size, CHUNK_SIZE));
+    }
+    chunk->used = 0;
+    chunk->generation = generation;
+    return chunk;
+}
+
+void put(std::byte *out, const astra::AlogRecord &record, std::span<const std::span<const std::byte>> parts) {
+    std::memcpy(out, &record, sizeof(record));
+    out += sizeof(record);
+    for (const auto &part: parts) {
+        std::memcpy(out, part.data(), part.size());
+        out += part.size();
+    }
+}
+
+void define(
+        BinlogState &s,
+        astra::binlog::Site &site,
+        const std::span<const astra::AlogArg> types,
+        const std::uint64_t time) {
+    std::lock_guard lock(s.mutex);
+    const auto generation = s.generation.load(std::memory_order_relaxed);
+    if (site.generation.load(std::memory_order_relaxed) == generation) return; // another thread got here first
+
+    const auto def = astra::AlogSite{
+            s.next_id++,
+            site.line,
+            static_cast<std::uint8_t>(site.level),
+            static_cast<std::uint8_t>(types.size()),
+            static_cast<std::uint16_t>(site.file.size()),
+            static_cast<std::uint32_t>(site.format.size())};
+    const std::span<const std::byte> parts[] = {
+            std::as_bytes(std::span(&def, 1)),
+            std::as_bytes(types),
+            std::as_bytes(std::span(site.file.data(), def.file_size)),
+            std::as_bytes(std::span(site.format.data(), site.format.size()))};
+
+    auto size = std::size_t{0};
+    for (const auto &part: parts) size += part.size();
+    const auto at = s.definitions.size();
+    s.definitions.resize(at + sizeof(astra::AlogRecord) + size);
+    put(s.definitions.data() + at, {astra::ALOG_SITE_DEFINITION, static_cast<std::uint32_t>(size), time}, parts);
+
+    site.id.store(def.id, std::memory_order_relaxed);
+    site.generation.store(generation, std::memory_order_release);
+}
+
+// Hands every thread's partial chunk to the writer, used by flush() and close()
+void collect_partial(BinlogState &s) {
+    std::vector<std::shared_ptr<ThreadBuffer>> threads;
+    {
+        std::lock_guard lock(s.mutex);
+        threads = s.threads;
+    }
+    for (const auto &t: threads) {
+        std::lock_guard thread_lock(t->mutex);
+        std::lock_guard lock(s.mutex);
+        hand_off(s, t->chunk);
+    }
+}
+
+void run_writer(BinlogState &s) {
+    std::vector<std::byte> definitions;
+    std::vector<std::unique_ptr<BinlogChunk>> full;
+
+    std::unique_lock lock(s.mutex);
+    while (true) {
+        s.wake.wait(lock, [&] {
+            return s.stopping || !s.full.empty() || !s.definitions.empty() || s.flush_done != s.flush_requested;
+        });
+
+        definitions.swap(s.definitions);
+        full.swap(s.full);
+        const auto flush_to = s.flush_requested;
+        const auto stopping = s.stopping;
+        const auto generation = s.generation.load(std::memory_order_relaxed);
+        lock.unlock();
+
+        s.ofs.write(
+                reinterpret_cast<const char *>(definitions.data()), static_cast<std::streamsize>(definitions.size()));
+        definitions.clear();
+        for (const auto &chunk: full) {
+            if (chunk->generation != generation) continue; // filled before a reopen, its site ids mean nothing here
+            s.ofs.write(reinterpret_cast<const char *>(chunk->data.data()), static_cast<std::streamsize>(chunk->used));
+        }
+        if (flush_to != s.flush_done || stopping) s.ofs.flush();
+
+        lock.lock();
+        for (auto &chunk: full)
+            if (s.free.size() < MAX_FREE_CHUNKS && chunk->data.size() == CHUNK_SIZE) s.free.push_back(std::move(chunk));
+        full.clear();
+        s.flush_done = flush_to;
+        s.flushed.notify_all();
+
+        if (stopping && s.full.empty() && s.definitions.empty()) return;
+    }
+}
+
+void astra::binlog::detail::append(
+        Site &site, const std::span<const AlogArg> types, const std::span<const std::byte> args) {
+    auto &s = state();
+    const auto time = static_cast<std::uint64_t>(time_ns() - s.start_ns.load(std::memory_order_relaxed));
+
+    auto generation = s.generation.load(std::memory_order_acquire);
+    if (site.generation.load(std::memory_order_acquire) != generation) {
+        define(s, site, types, time);
+        generation = site.generation.load(std::memory_order_acquire);
+    }
+    const auto id = site.id.load(std::memory_order_relaxed);
+    const auto record = AlogRecord{id, static_cast<std::uint32_t>(args.size()), time};
+    const auto size = sizeof(AlogRecord) + args.size();
+
+    auto &t = thread_buffer();
+    std::lock_guard thread_lock(t.mutex);
+    if (!t.chunk || t.chunk->generation != generation || t.chunk->used + size > t.chunk->data.size()) {
+        std::lock_guard lock(s.mutex);
+        if (t.chunk && t.chunk->generation == generation) hand_off(s, t.chunk);
+        t.chunk = take_chunk(s, size, generation);
+        s.wake.notify_one();
+    }
+
+    const std::span<const std::byte> parts[] = {args};
+    put(t.chunk->data.data() + t.chunk->used, record, parts);
+    t.chunk->used += size;
+
+    // errors are the messages most likely to be followed by a crash, get them to the writer right away
+    if (site.level >= spdlog::level::err) {
+        std::lock_guard lock(s.mutex);
+        hand_off(s, t.chunk);
+        ++s.flush_requested;
+        s.wake.notify_one();
+    }
+}
+
+bool astra::binlog::open(const std::filesystem::path &path) {
+    close();
+
+    auto &s = state();
+    std::lock_guard lock(s.mutex);
+
+    if (path.has_parent_path()) {
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+
+    s.ofs = std::ofstream(path, std::ios::binary);
+    if (!s.ofs.is_open()) {
+        ASTRA_LOG_ERROR("Failed to open binary log '{}'", path);
+        return false;
+    }
+
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    const auto header = AlogHeader{
+            ALOG_MAGIC, ALOG_VERSION, std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()};
+    s.ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    s.start_ns.store(time_ns(), std::memory_order_relaxed);
+    s.definitions.clear();
+    s.full.clear();
+    s.next_id = 1;
+    s.stopping = false;
+    s.generation.fetch_add(1, std::memory_order_release); // every site defines itself again in the new file
+    s.writer = std::thread([&s] { run_writer(s); });
+    s.open.store(true, std::memory_order_release);
+    return true;
+}
+
+void astra::binlog::close() {
+    auto &s = state();
+    if (!s.open.exchange(false, std::memory_order_acq_rel)) return;
+
+    collect_partial(s);
+    {
+        std::lock_guard lock(s.mutex);
+        s.stopping = true;
+        s.wake.notify_one();
+    }
+    s.writer.join();
+    s.ofs.close();
+}
+
+void astra::binlog::flush() {
+    auto &s = state();
+    if (!s.open.load(std::memory_order_acquire)) return;
+
+    collect_partial(s);
+    std::unique_lock lock(s.mutex);
+    const auto target = ++s.flush_requested;
+    s.wake.notify_one();
+    s.flushed.wait(lock, [&] { return s.flush_done >= target || s.stopping; });
+}
+
+bool astra::binlog::is_open() {
+    return state().open.load(std::memory_order_acquire);
+}
@@ -1,5 +1,7 @@
 #include "astra/core/color.hpp"
 
+#include "astra/core/color_kernels.hpp"
+
 #include <algorithm>
 
 glm::vec4 astra::Color::gl_color(std::uint8_t override_alpha) {
@@ -43,80 +45,18 @@ astra::RGB::RGB(const std::uint8_t r, const std::uint8_t g, const std::uint8_t b
 
 astra::RGB::RGB(const HSL &hsl)
     : a(hsl.a) {
-    const auto c = (1.0f - std::abs(2.0f * hsl.l - 1.0f)) * hsl.s;
-    const auto hp = hsl.h / 60.0f;
-    const auto x = c * (1.0f - std::abs(std::fmodf(hp, 2.0f) - 1.0f));
-    const auto m = hsl.l - c / 2.0f;
-
-    float r1, g1, b1;
-    if (hp < 1.0f) {
-        r1 = c;
-        g1 = x;
-        b1 = 0.0f;
-    } else if (hp < 2.0f) {
-        r1 = x;
-        g1 = c;
-        b1 = 0.0f;
-    } else if (hp < 3.0f) {
-        r1 = 0.0f;
-        g1 = c;
-        b1 = x;
-    } else if (hp < 4.0f) {
-        r1 = 0.0f;
-        g1 = x;
-        b1 = c;
-    } else if (hp < 5.0f) {
-        r1 = x;
-        g1 = 0.0f;
-        b1 = c;
-    } else {
-        r1 = c;
-        g1 = 0.0;
-        b1 = x;
-    }
-
-    r = static_cast<std::uint8_t>(std::round(255.0f * (r1 + m)));
-    g = static_cast<std::uint8_t>(std::round(255.0f * (g1 + m)));
-    b = static_cast<std::uint8_t>(std::round(255.0f * (b1 + m)));
+    const auto c = color::hsl_to_rgb({hsl.h, hsl.s, hsl.l, 1.0f});
+    r = static_cast<std::uint8_t>(std::round(255.0f * c.r));
+    g = static_cast<std::uint8_t>(std::round(255.0f * c.g));
+    b = static_cast<std::uint8_t>(std::round(255.0f * c.b));
 }
 
 astra::RGB::RGB(const HSV &hsv)
     : a(hsv.a) {
-    const auto c = hsv.v * hsv.s;
-    const auto hp = hsv.h / 60.0f;
-    const auto x = c * (1.0f - std::abs(std::fmodf(hp, 2.0f) - 1.0f));
-    const auto m = hsv.v - c;
-
-    float r1, g1, b1;
-    if (hp < 1.0f) {
-        r1 = c;
-        g1 = x;
-        b1 = 0.0f;
-    } else if (hp < 2.0f) {
-        r1 = x;
-        g1 = c;
-        b1 = 0.0f;
-    } else if (hp < 3.0f) {
-        r1 = 0.0f;
-        g1 = c;
-        b1 = x;
-    } else if (hp < 4.0f) {
-        r1 = 0.0f;
-        g1 = x;
-        b1 = c;
-    } else if (hp < 5.0f) {
-        r1 = x;
-        g1 = 0.0f;
-        b1 = c;
-    } else {
-        r1 = c;
-        g1 = 0.0;
-        b1 = x;
-    }
-
-    r = static_cast<std::uint8_t>(std::round(255.0f * (r1 + m)));
-    g = static_cast<std::uint8_t>(std::round(255.0f * (g1 + m)));
-    b = static_cast<std::uint8_t>(std::round(255.0f * (b1 + m)));
+    const auto c = color::hsv_to_rgb({hsv.h, hsv.s, hsv.v, 1.0f});
+    r = static_cast<std::uint8_t>(std::round(255.0f * c.r));
+    g = static_cast<std::uint8_t>(std::round(255.0f * c.g));
+    b = static_cast<std::uint8_t>(std::round(255.0f * c.b));
 }
 
 astra::RGB astra::rgba(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a) {
@@ -160,20 +100,10 @@ astra::HSL::HSL()
 
 astra::HSL::HSL(const RGB &rgb)
     : a(rgb.a) {
-    const auto rgb_f = rgb.gl_color();
-
-    const auto x_max = std::max(rgb_f.r, std::max(rgb_f.g, rgb_f.b));
-    const auto x_min = std::min(rgb_f.r, std::min(rgb_f.g, rgb_f.b));
-    const auto delta = x_max - x_min;
-
-    if (delta == 0.0f) h = 0.0f;
-    else if (x_max == rgb_f.r) h = 60.0f * std::fmodf((rgb_f.g - rgb_f.b) / delta, 6.0f);
-    else if (x_max == rgb_f.g) h = 60.0f * ((rgb_f.b - rgb_f.r) / delta + 2.0f);
-    else h = 60.0f * ((rgb_f.r - rgb_f.g) / delta + 4.0f);
-
-    l = (x_max + x_min) / 2.0f;
-
-    s = delta == 0.0f ? 0.0f : delta / (1.0f - std::abs(2.0f * l - 1.0f));
+    const auto c = color::rgb_to_hsl(rgb.gl_color());
+    h = c[0];
+    s = c[1];
+    l = c[2];
 }
 
 astra::HSL::HSL(const HSV &hsv)
@@ -217,20 +147,10 @@ astra::HSV::HSV()
 
 astra::HSV::HSV(const RGB &rgb)
     : a(rgb.a) {
-    const auto rgb_f = rgb.gl_color();
-
-    const auto x_max = std::max(rgb_f.r, std::max(rgb_f.g, rgb_f.b));
-    const auto x_min = std::min(rgb_f.r, std::min(rgb_f.g, rgb_f.b));
-    const auto delta = x_max - x_min;
-
-    if (delta == 0.0f) h = 0.0f;
-    else if (x_max == rgb_f.r) h = 60.0f * std::fmodf((rgb_f.g - rgb_f.b) / delta, 6.0f);
-    else if (x_max == rgb_f.g) h = 60.0f * ((rgb_f.b - rgb_f.r) / delta + 2.0f);
-    else h = 60.0f * ((rgb_f.r - rgb_f.g) / delta + 4.0f);
-
-    s = x_max == 0.0f ? 0.0f : delta / x_max;
-
-    v = x_max;
+    const auto c = color::rgb_to_hsv(rgb.gl_color());
+    h = c[0];
+    s = c[1];
+    v = c[2];
 }
 
 astra::HSV::HSV(const HSL &hsl)
@@ -269,6 +189,26 @@ astra::HSV astra::hsv(float h, float s, float v) {
     return {std::fmodf(h, 360.0f), std::clamp(s, 0.0f, 1.0f), std::clamp(v, 0.0f, 1.0f), 255};
 }
 
+astra::rgba8::rgba8(const RGB &rgb)
+    : rgba8(rgb.r, rgb.g, rgb.b, rgb.a) {}
+
+astra::rgba8::rgba8(const HSL &hsl)
+    : rgba8(RGB(hsl)) {}
+
+astra::rgba8::rgba8(const HSV &hsv)
+    : rgba8(RGB(hsv)) {}
+
+glm::vec4 astra::rgba8::gl_color() const {
+    return {static_cast<float>(r) / 255.0f,
+            static_cast<float>(g) / 255.0f,
+            static_cast<float>(b) / 255.0f,
+            static_cast<float>(a) / 255.0f};
+}
+
+astra::RGB astra::rgba8::rgb() const {
+    return rgba(r, g, b, a);
+}
+
 astra::RGB astra::rng::rgb() {
     return rgba({0, 255}, {0, 255}, {0, 255}, {255, 255});
 }
@@ -0,0 +1,184 @@
+#include "astra/core/color_kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Hue in degrees from the channel that's the max, every candidate is computed and one is picked
+inline float hue(const glm::vec4 c, const float x_max, const float delta) {
+    const auto safe_delta = delta > 0.0f ? delta : 1.0f;
+    const auto h_r = (c.g - c.b) / safe_delta + (c.g < c.b ? 6.0f : 0.0f);
+    const auto h_g = (c.b - c.r) / safe_delta + 2.0f;
+    const auto h_b = (c.r - c.g) / safe_delta + 4.0f;
+    const auto h = x_max == c.r ? h_r : (x_max == c.g ? h_g : h_b);
+    return delta > 0.0f ? 60.0f * h : 0.0f;
+}
+
+inline float wrap(const float x, const float period) {
+    return x - period * std::floor(x / period);
+}
+
+inline glm::vec4 rgb_to_hsl_kernel(const glm::vec4 c) {
+    const auto x_max = std::max(c.r, std::max(c.g, c.b));
+    const auto x_min = std::min(c.r, std::min(c.g, c.b));
+    const auto delta = x_max - x_min;
+
+    const auto l = (x_max + x_min) / 2.0f;
+    const auto denominator = 1.0f - std::abs(2.0f * l - 1.0f);
+    const auto s = delta > 0.0f && denominator > 0.0f ? delta / denominator : 0.0f;
+    return {hue(c, x_max, delta), s, l, c.a};
+}
+
+inline glm::vec4 rgb_to_hsv_kernel(const glm::vec4 c) {
+    const auto x_max = std::max(c.r, std::max(c.g, c.b));
+    const auto x_min = std::min(c.r, std::min(c.g, c.b));
+    const auto delta = x_max - x_min;
+
+    const auto s = x_max > 0.0f ? delta / x_max : 0.0f;
+    return {hue(c, x_max, delta), s, x_max, c.a};
+}
+
+// Closed forms from the hue wheel, f(n) for n = r, g, b offsets, instead of a branch per 60 degree sector
+inline glm::vec4 hsl_to_rgb_kernel(const glm::vec4 c) {
+    const auto h = c[0] / 30.0f;
+    const auto a = c[1] * std::min(c[2], 1.0f - c[2]);
+    const auto f = [&](const float n) {
+        const auto k = wrap(n + h, 12.0f);
+        return c[2] - a * std::max(-1.0f, std::min(std::min(k - 3.0f, 9.0f - k), 1.0f));
+    };
+    return {f(0.0f), f(8.0f), f(4.0f), c[3]};
+}
+
+inline glm::vec4 hsv_to_rgb_kernel(const glm::vec4 c) {
+    const auto h = c[0] / 60.0f;
+    const auto f = [&](const float n) {
+        const auto k = wrap(n + h, 6.0f);
+        return c[2] - c[2] * c[1] * std::max(0.0f, std::min(std::min(k, 4.0f - k), 1.0f));
+    };
+    return {f(5.0f), f(3.0f), f(1.0f), c[3]};
+}
+
+inline float srgb_to_linear_kernel(const float x) {
+    const auto low = x / 12.92f;
+    const auto high = std::pow((x + 0.055f) / 1.055f, 2.4f);
+    return x <= 0.04045f ? low : high;
+}
+
+inline float linear_to_srgb_kernel(const float x) {
+    const auto low = x * 12.92f;
+    const auto high = 1.055f * std::pow(std::max(x, 0.0f), 1.0f / 2.4f) - 0.055f;
+    return x <= 0.0031308f ? low : high;
+}
+
+inline std::uint8_t pack_byte(const float x) {
+    return static_cast<std::uint8_t>(std::clamp(x, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+inline std::uint32_t pack_channel(const float x, const int shift) {
+    return static_cast<std::uint32_t>(pack_byte(x)) << shift;
+}
+
+inline float unpack_channel(const std::uint32_t packed, const int shift) {
+    return static_cast<float>(packed >> shift & 0xff) * (1.0f / 255.0f);
+}
+
+template<typename F>
+void transform(const std::span<const glm::vec4> in, const std::span<glm::vec4> out, F &&f) {
+    const auto n = std::min(in.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) out[i] = f(in[i]);
+}
+
+void astra::color::hsl_to_rgb(const std::span<const glm::vec4> in, const std::span<glm::vec4> out) {
+    transform(in, out, [](const glm::vec4 c) { return hsl_to_rgb_kernel(c); });
+}
+
+void astra::color::rgb_to_hsl(const std::span<const glm::vec4> in, const std::span<glm::vec4> out) {
+    transform(in, out, [](const glm::vec4 c) { return rgb_to_hsl_kernel(c); });
+}
+
+void astra::color::hsv_to_rgb(const std::span<const glm::vec4> in, const std::span<glm::vec4> out) {
+    transform(in, out, [](const glm::vec4 c) { return hsv_to_rgb_kernel(c); });
+}
+
+void astra::color::rgb_to_hsv(const std::span<const glm::vec4> in, const std::span<glm::vec4> out) {
+    transform(in, out, [](const glm::vec4 c) { return rgb_to_hsv_kernel(c); });
+}
+
+void astra::color::srgb_to_linear(const std::span<const glm::vec4> in, const std::span<glm::vec4> out) {
+    transform(in, out, [](const glm::vec4 c) {
+        return glm::vec4(
+                srgb_to_linear_kernel(c[0]), srgb_to_linear_kernel(c[1]), srgb_to_linear_kernel(c[2]), c[3]);
+    });
+}
+
+void astra::color::linear_to_srgb(const std::span<const glm::vec4> in, const std::span<glm::vec4> out) {
+    transform(in, out, [](const glm::vec4 c) {
+        return glm::vec4(
+                linear_to_srgb_kernel(c[0]), linear_to_srgb_kernel(c[1]), linear_to_srgb_kernel(c[2]), c[3]);
+    });
+}
+
+void astra::color::pack(const std::span<const glm::vec4> in, const std::span<std::uint32_t> out) {
+    const auto n = std::min(in.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto &c = in[i];
+        out[i] = pack_channel(c[0], 0) | pack_channel(c[1], 8) | pack_channel(c[2], 16) | pack_channel(c[3], 24);
+    }
+}
+
+void astra::color::pack(const std::span<const glm::vec4> in, const std::span<rgba8> out) {
+    const auto n = std::min(in.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto &c = in[i];
+        out[i] = {pack_byte(c[0]), pack_byte(c[1]), pack_byte(c[2]), pack_byte(c[3])};
+    }
+}
+
+void astra::color::unpack(const std::span<const std::uint32_t> in, const std::span<glm::vec4> out) {
+    const auto n = std::min(in.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto p = in[i];
+        out[i] = {unpack_channel(p, 0), unpack_channel(p, 8), unpack_channel(p, 16), unpack_channel(p, 24)};
+    }
+}
+
+void astra::color::unpack(const std::span<const rgba8> in, const std::span<glm::vec4> out) {
+    const auto n = std::min(in.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto c = in[i];
+        out[i] = {static_cast<float>(c.r) * (1.0f / 255.0f),
+                  static_cast<float>(c.g) * (1.0f / 255.0f),
+                  static_cast<float>(c.b) * (1.0f / 255.0f),
+                  static_cast<float>(c.a) * (1.0f / 255.0f)};
+    }
+}
+
+void astra::color::unpack(const std::span<const RGB> in, const std::span<glm::vec4> out) {
+    const auto n = std::min(in.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto &c = in[i];
+        out[i] = {static_cast<float>(c.r) * (1.0f / 255.0f),
+                  static_cast<float>(c.g) * (1.0f / 255.0f),
+                  static_cast<float>(c.b) * (1.0f / 255.0f),
+                  static_cast<float>(c.a) * (1.0f / 255.0f)};
+    }
+}
+
+void astra::color::rotate_hue(const std::span<glm::vec4> colors, const float offset) {
+    for (auto &c: colors) c[0] = wrap(c[0] + offset, 360.0f);
+}
+
+glm::vec4 astra::color::hsl_to_rgb(const glm::vec4 hsla) {
+    return hsl_to_rgb_kernel(hsla);
+}
+
+glm::vec4 astra::color::rgb_to_hsl(const glm::vec4 rgba) {
+    return rgb_to_hsl_kernel(rgba);
+}
+
+glm::vec4 astra::color::hsv_to_rgb(const glm::vec4 hsva) {
+    return hsv_to_rgb_kernel(hsva);
+}
+
+glm::vec4 astra::color::rgb_to_hsv(const glm::vec4 rgba) {
+    return rgb_to_hsv_kernel(rgba);
+}
@@ -1,44 +1,79 @@
 #include "astra/core/init.hpp"
+#include "astra/core/binlog.hpp"
 #include "astra/core/color.hpp"
 #include "astra/core/globals.hpp"
 #include "astra/core/log.hpp"
 #include "astra/core/payloads.hpp"
 #include "astra/util/platform.hpp"
+#include "astra/util/profile.hpp"
 #include "astra/util/rng.hpp"
+#include "astra/util/time.hpp"
+#include "gloo/counters.hpp"
 #include "gloo/init.hpp"
+#include "gloo/state.hpp"
 #include "sdl3_raii/event_pump.hpp"
 #include "sdl3_raii/events/quit.hpp"
 #include "sdl3_raii/gl_attr.hpp"
 
 #include <spdlog/sinks/callback_sink.h>
 
-#include <deque>
+#include <algorithm>
+#include <array>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 
 // TODO: The debug overlay shouldn't really be in here, should get moved to its own file
 //  state could possible be stored globally in `astra::g.internal`
 
-class MessengerSink final : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+// Hermes is main thread only, messages logged from other threads (IoService workers, the async log writer, etc.) are
+// held until the next PreUpdate. Recursive so a LogMessage subscriber can itself log.
+class MessengerSink final : public spdlog::sinks::base_sink<std::recursive_mutex> {
+public:
+    void publish_deferred() {
+        std::vector<std::pair<spdlog::level::level_enum, std::string>> deferred;
+        {
+            std::lock_guard lock(mutex_);
+            deferred.swap(deferred_);
+        }
+        for (auto &[level, text]: deferred) astra::g.hermes->publish<astra::LogMessage>(level, std::move(text));
+    }
+
 protected:
     void sink_it_(const spdlog::details::log_msg &msg) override {
         spdlog::memory_buf_t formatted;
         formatter_->format(msg, formatted);
-        astra::g.hermes->publish<astra::LogMessage>(msg.level, fmt::to_string(formatted));
+        if (std::this_thread::get_id() == main_thread_id_)
+            astra::g.hermes->publish<astra::LogMessage>(msg.level, fmt::to_string(formatted));
+        else deferred_.emplace_back(msg.level, fmt::to_string(formatted));
     }
     void flush_() override { /* do nothing */ }
+
+private:
+    std::thread::id main_thread_id_{std::this_thread::get_id()};
+    std::vector<std::pair<spdlog::level::level_enum, std::string>> deferred_;
 };
 
+std::shared_ptr<MessengerSink> &messenger_sink() {
+    static std::shared_ptr<MessengerSink> sink;
+    return sink;
+}
+
 void setup_engine_callbacks();
 
 void astra::init(const sdl3::AppInfo &app_info, const std::function<sdl3::WindowBuilder()> &window_builder_f) {
+    // before anything else starts logging, a burst of GL debug output shouldn't stall the frame on console writes
+    enable_async_logging();
+
     g.hermes = std::make_unique<Hermes>();
 
     setup_engine_callbacks();
 
-    const auto callback_sink = std::make_shared<MessengerSink>();
-    callback_sink->set_pattern("[%H:%M:%S] [%L] %v");
-    callback_sink->set_level(spdlog::level::trace);
-    logger_sinks()->add_sink(callback_sink);
+    messenger_sink() = std::make_shared<MessengerSink>();
+    messenger_sink()->set_pattern("[%H:%M:%S] [%L] %v");
+    messenger_sink()->set_level(spdlog::level::trace);
+    logger_sinks()->add_sink(messenger_sink());
 
     log_platform();
     rng::log_seed();
@@ -60,27 +95,107 @@ void astra::init(const sdl3::AppInfo &app_info, const std::function<sdl3::Window
         throw std::runtime_error("Failed to build SDL3 window");
     }
     gloo::init();
+#if defined(ASTRA_PROFILE_ENABLED)
+    g.gpu_timer = std::make_unique<gloo::GpuTimer>();
+#endif
 
     g.dear = std::make_unique<Dear>(*g.window);
+    g.io = std::make_unique<IoService>();
     g.shaders = std::make_unique<ShaderMgr>();
 }
 
 void astra::shutdown() {
+    binlog::close();
+
     g.shaders.reset();
+    g.io.reset();
+    disable_async_logging(); // after the IoService workers are joined, before Hermes goes
     g.dear.reset();
+    g.gpu_timer.reset();
     g.window.reset();
     g.hermes.reset();
 
     sdl3::exit();
 }
 
-struct LogFlyout_ {
-    spdlog::level::level_enum level;
-    std::string text;
-    double acc;
+/* On-screen log lines, a fixed ring so a flood of messages can't grow it or the per-frame draw
+ *
+ * A message that's already on screen (same level and text, ignoring the leading timestamp) bumps that line's count
+ * and timer instead of taking a new one. Slots keep their strings, so once they're warm nothing allocates.
+ */
+class LogFlyouts_ {
+public:
+    static constexpr std::size_t CAPACITY = 32;
+    static constexpr double LIFETIME = 5.0;
+
+    struct Entry {
+        spdlog::level::level_enum level{spdlog::level::off};
+        std::string text;
+        std::size_t hash{0};
+        std::uint32_t count{0};
+        double acc{0.0};
+    };
+
+    void push(const spdlog::level::level_enum level, const std::string_view text) {
+        const auto hash = std::hash<std::string_view>{}(key_(text));
+        for (std::size_t i = 0; i < size_; ++i) {
+            auto &e = at_(i);
+            if (e.acc > 0.0 && e.hash == hash && e.level == level && key_(e.text) == key_(text)) {
+                e.text.assign(text); // keep the newest timestamp
+                ++e.count;
+                e.acc = LIFETIME;
+                return;
+            }
+        }
+
+        if (size_ == CAPACITY) {
+            start_ = (start_ + 1) % CAPACITY;
+            --size_;
+        }
+        auto &e = at_(size_++);
+        e.level = level;
+        e.text.assign(text);
+        e.hash = hash;
+        e.count = 1;
+        e.acc = LIFETIME;
+    }
+
+    void update(const double dt) {
+        for (std::size_t i = 0; i < size_; ++i) at_(i).acc -= dt;
+
+        // a repeated message can outlive newer ones, those just sit expired until it goes
+        while (size_ > 0 && at_(0).acc <= 0.0) {
+            start_ = (start_ + 1) % CAPACITY;
+            --size_;
+        }
+    }
+
+    template<typename F>
+    void for_each_newest_first(F &&f) const {
+        for (std::size_t i = size_; i-- > 0;) {
+            const auto &e = entries_[(start_ + i) % CAPACITY];
+            if (e.acc > 0.0 && !f(e)) return;
+        }
+    }
+
+private:
+    std::array<Entry, CAPACITY> entries_{};
+    std::size_t start_{0};
+    std::size_t size_{0};
+
+    Entry &at_(const std::size_t i) {
+        return entries_[(start_ + i) % CAPACITY];
+    }
+
+    // "[%H:%M:%S] [%L] %v" from the messenger sink, everything after the timestamp
+    static std::string_view key_(const std::string_view text) {
+        const auto end = text.find("] ");
+        return end == std::string_view::npos ? text : text.substr(end + 2);
+    }
 };
-std::deque<LogFlyout_> &log_flyouts() {
-    static std::deque<LogFlyout_> flyouts;
+
+LogFlyouts_ &log_flyouts() {
+    static LogFlyouts_ flyouts;
     return flyouts;
 }
 
@@ -89,19 +204,54 @@ void draw_debug_overlay();
 void astra::mainloop() {
     g.running = true;
 
+    profile::set_thread_name("main");
+
     while (g.running) {
-        sdl3::pump_events();
+        ASTRA_PROFILE_SCOPE("frame");
+        if (g.gpu_timer) g.gpu_timer->new_frame();
+        gloo::state::invalidate();
 
-        g.hermes->publish<PreUpdate>(g.frame_counter.dt());
-        g.hermes->publish<Update>(g.frame_counter.dt());
-        g.hermes->publish<PostUpdate>(g.frame_counter.dt());
+        {
+            ASTRA_PROFILE_SCOPE("pump_events");
+            sdl3::pump_events();
+        }
 
-        g.hermes->publish<PreDraw>();
-        g.hermes->publish<Draw>();
-        draw_debug_overlay();
-        g.hermes->publish<PostDraw>();
+        {
+            ASTRA_PROFILE_SCOPE("PreUpdate");
+            g.hermes->publish<PreUpdate>(g.frame_counter.dt());
+        }
+        {
+            ASTRA_PROFILE_SCOPE("Update");
+            g.hermes->publish<Update>(g.frame_counter.dt());
+        }
+        {
+            ASTRA_PROFILE_SCOPE("PostUpdate");
+            g.hermes->publish<PostUpdate>(g.frame_counter.dt());
+        }
 
-        g.window->swap();
+        {
+            ASTRA_PROFILE_SCOPE("PreDraw");
+            g.hermes->publish<PreDraw>();
+        }
+        {
+            ASTRA_PROFILE_SCOPE("Draw");
+            const gloo::GpuTimer::Scope gpu_scope(g.gpu_timer.get(), "Draw");
+            g.hermes->publish<Draw>();
+        }
+        {
+            ASTRA_PROFILE_SCOPE("draw_debug_overlay");
+            draw_debug_overlay();
+        }
+        {
+            ASTRA_PROFILE_SCOPE("PostDraw");
+            g.hermes->publish<PostDraw>();
+        }
+
+        {
+            ASTRA_PROFILE_SCOPE("swap");
+            gloo::end_frame_counters();
+            g.window->swap();
+        }
 
         g.frame_counter.update();
     }
@@ -150,11 +300,16 @@ void draw_fps_and_latency(ImDrawList *dl) {
             max_w, text_with_bg(dl, pos, astra::rgb(0x000000), astra::rgb(0xffffff), 255, min_fps_text.c_str()));
     pos.y += ImGui::GetTextLineHeightWithSpacing();
 
+    const auto p99_text = fmt::format("P99: {:.1f}ms", astra::g.frame_counter.frame_time_quantile(0.99) * 1000.0);
+    max_w = std::max(
+            max_w, text_with_bg(dl, pos, astra::rgb(0x000000), astra::rgb(0xffffff), 255, p99_text.c_str()));
+    pos.y += ImGui::GetTextLineHeightWithSpacing();
+
     ImGui::SetCursorPos({ImGui::GetStyle().WindowPadding.x + max_w + 4.0f, ImGui::GetStyle().WindowPadding.y});
     ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0.0f, 0.0f));
     if (ImPlot::BeginPlot(
                 "latency",
-                {300, ImGui::GetTextLineHeightWithSpacing() * 3},
+                {300, ImGui::GetTextLineHeightWithSpacing() * 4},
                 ImPlotFlags_NoTitle | ImPlotFlags_NoFrame)) {
         ImPlot::SetupAxes(
                 "",
@@ -168,35 +323,297 @@ void draw_fps_and_latency(ImDrawList *dl) {
 }
 
 void draw_log_flyouts(ImDrawList *dl) {
-    const static std::unordered_map<spdlog::level::level_enum, astra::RGB> bg_colors = {
-            {spdlog::level::trace, astra::rgb(0x000000)},
-            {spdlog::level::debug, astra::rgb(0x000000)},
-            {spdlog::level::info, astra::rgb(0x000000)},
-            {spdlog::level::warn, astra::rgb(0x000000)},
-            {spdlog::level::err, astra::rgb(0x000000)},
-            {spdlog::level::critical, astra::rgb(0x000000)},
+    // indexed by level, off included so any level_enum is in range
+    const static std::array<astra::RGB, spdlog::level::n_levels> bg_colors = {
+            astra::rgb(0x000000),
+            astra::rgb(0x000000),
+            astra::rgb(0x000000),
+            astra::rgb(0x000000),
+            astra::rgb(0x000000),
+            astra::rgb(0x000000),
+            astra::rgb(0x000000),
     };
 
-    const static std::unordered_map<spdlog::level::level_enum, astra::RGB> fg_colors = {
-            {spdlog::level::trace, astra::rgb(0x7f7f7f)},
-            {spdlog::level::debug, astra::rgb(0x5c5cff)},
-            {spdlog::level::info, astra::rgb(0x00ff00)},
-            {spdlog::level::warn, astra::rgb(0xffff00)},
-            {spdlog::level::err, astra::rgb(0xff0000)},
-            {spdlog::level::critical, astra::rgb(0xffffff)},
+    const static std::array<astra::RGB, spdlog::level::n_levels> fg_colors = {
+            astra::rgb(0x7f7f7f),
+            astra::rgb(0x5c5cff),
+            astra::rgb(0x00ff00),
+            astra::rgb(0xffff00),
+            astra::rgb(0xff0000),
+            astra::rgb(0xffffff),
+            astra::rgb(0xffffff),
     };
 
+    // reused across frames, only a repeated message needs its "xN" appended
+    static fmt::memory_buffer line;
+
     auto pos = ImVec2{ImGui::GetStyle().WindowPadding.x, ImGui::GetWindowSize().y - ImGui::GetStyle().WindowPadding.y};
-    for (auto &[level, text, acc]: log_flyouts()) {
+    log_flyouts().for_each_newest_first([&](const LogFlyouts_::Entry &e) {
         pos.y -= ImGui::GetTextLineHeightWithSpacing();
+        if (pos.y < 0.0f) return false;
+
+        auto text = e.text.c_str();
+        if (e.count > 1) {
+            line.clear();
+            fmt::format_to(std::back_inserter(line), "{} x{}", e.text, e.count);
+            line.push_back('\0');
+            text = line.data();
+        }
+
         text_with_bg(
                 dl,
                 pos,
-                bg_colors.at(level),
-                fg_colors.at(level),
-                static_cast<std::uint8_t>(255.0 * std::clamp(acc, 0.0, 1.0)),
-                text.c_str());
+                bg_colors[e.level],
+                fg_colors[e.level],
+                static_cast<std::uint8_t>(255.0 * std::clamp(e.acc, 0.0, 1.0)),
+                text);
+        return true;
+    });
+}
+
+/* The main thread's profile zones over the last few frames, one row per nesting level
+ *
+ * Unlike the fps graph nothing is averaged, so a single slow frame and the zone that made it slow are both visible.
+ * The snapshot can be frozen by hand or when a frame goes over the spike threshold, then exported as a Chrome trace.
+ */
+void draw_frame_timeline() {
+    static std::vector<astra::profile::ThreadZones> snapshot;
+    static bool frozen = false;
+    static int frame_count = 8;
+    static float spike_ms = 0.0f;
+
+    ImGui::Checkbox("freeze", &frozen);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100.0f);
+    ImGui::SliderInt("frames", &frame_count, 1, 60);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100.0f);
+    ImGui::DragFloat("freeze above", &spike_ms, 0.1f, 0.0f, 1000.0f, spike_ms > 0.0f ? "%.1f ms" : "off");
+
+    if (!frozen) snapshot = astra::profile::collect();
+
+    const auto main_thread = std::ranges::find(snapshot, "main", &astra::profile::ThreadZones::thread_name);
+    if (main_thread == snapshot.end()) {
+#if defined(ASTRA_PROFILE_ENABLED)
+        ImGui::TextDisabled("no zones from the main thread yet");
+#else
+        ImGui::TextDisabled("built without ASTRA_PROFILE, no zones");
+#endif
+        return;
+    }
+    const auto &zones = main_thread->zones;
+
+    // zones are stored as they end, so the newest "frame" zones are at the back and their children come before them
+    std::vector<const astra::profile::Zone *> frames;
+    for (auto it = zones.rbegin(); it != zones.rend() && frames.size() < static_cast<std::size_t>(frame_count); ++it)
+        if (it->depth == 0 && it->name && std::string_view(it->name) == "frame") frames.push_back(&*it);
+    if (frames.empty()) {
+        ImGui::TextDisabled("no complete frames yet");
+        return;
+    }
+
+    if (!frozen && spike_ms > 0.0f &&
+        static_cast<double>(frames.front()->end_ns - frames.front()->begin_ns) / 1e6 > spike_ms)
+        frozen = true;
+
+    const auto t0 = frames.back()->begin_ns;
+    const auto t1 = frames.front()->end_ns;
+    const auto span_ns = static_cast<double>(std::max<std::int64_t>(t1 - t0, 1));
+
+    std::uint32_t max_depth = 0;
+    for (const auto &z: zones)
+        if (z.begin_ns >= t0 && z.end_ns <= t1) max_depth = std::max(max_depth, z.depth);
+
+    ImGui::SameLine();
+    if (ImGui::Button("Export")) {
+        // just the frames on screen, from every thread
+        std::vector<astra::profile::ThreadZones> window;
+        for (const auto &t: snapshot) {
+            auto &w = window.emplace_back(t.thread_index, t.thread_name, std::vector<astra::profile::Zone>{});
+            for (const auto &z: t.zones)
+                if (z.end_ns >= t0 && z.begin_ns <= t1) w.zones.push_back(z);
+        }
+        astra::profile::export_chrome_trace(
+                std::filesystem::path(".log") / fmt::format("{}.timeline.json", astra::timestamp()), window);
+    }
+
+    const auto row_h = ImGui::GetTextLineHeightWithSpacing();
+    const auto size = ImVec2{800.0f, row_h * static_cast<float>(max_depth + 1)};
+    const auto origin = ImGui::GetCursorScreenPos();
+    ImGui::InvisibleButton("##timeline", size);
+    const auto hovered = ImGui::IsItemHovered();
+    const auto mouse = ImGui::GetIO().MousePos;
+
+    const auto dl = ImGui::GetWindowDrawList();
+    dl->AddRectFilled(origin, {origin.x + size.x, origin.y + size.y}, IM_COL32(0, 0, 0, 160));
+
+    const astra::profile::Zone *hovered_zone = nullptr;
+    for (const auto &z: zones) {
+        if (z.end_ns < t0 || z.begin_ns > t1) continue;
+
+        const auto x0 = origin.x + static_cast<float>(static_cast<double>(z.begin_ns - t0) / span_ns) * size.x;
+        const auto x1 = origin.x + static_cast<float>(static_cast<double>(z.end_ns - t0) / span_ns) * size.x;
+        const auto y0 = origin.y + row_h * static_cast<float>(z.depth);
+        const auto min = ImVec2{std::max(x0, origin.x), y0};
+        const auto max = ImVec2{std::max(std::min(x1, origin.x + size.x), min.x + 1.0f), y0 + row_h - 1.0f};
+
+        // same name, same color, across frames and runs
+        const auto name = z.name ? std::string_view(z.name) : std::string_view("?");
+        const auto hue = static_cast<float>(std::hash<std::string_view>{}(name) % 360);
+        dl->AddRectFilled(min, max, astra::hsv(hue, 0.5f, 0.7f).imgui_color_u32());
+        if (max.x - min.x > ImGui::CalcTextSize(name.data(), name.data() + name.size()).x + 4.0f) {
+            const auto clip = ImVec4{min.x, min.y, max.x, max.y};
+            dl->AddText(
+                    nullptr,
+                    0.0f,
+                    {min.x + 2.0f, min.y},
+                    IM_COL32_WHITE,
+                    name.data(),
+                    name.data() + name.size(),
+                    0.0f,
+                    &clip);
+        }
+
+        if (hovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+            hovered_zone = &z;
     }
+
+    // frame boundaries
+    for (const auto *f: frames) {
+        const auto x = origin.x + static_cast<float>(static_cast<double>(f->begin_ns - t0) / span_ns) * size.x;
+        dl->AddLine({x, origin.y}, {x, origin.y + size.y}, IM_COL32(255, 255, 255, 96));
+    }
+
+    if (hovered_zone)
+        ImGui::SetTooltip(
+                "%s\n%.3f ms",
+                hovered_zone->name ? hovered_zone->name : "?",
+                static_cast<double>(hovered_zone->end_ns - hovered_zone->begin_ns) / 1e6);
+
+    auto slowest = 0.0;
+    for (const auto *f: frames) slowest = std::max(slowest, static_cast<double>(f->end_ns - f->begin_ns) / 1e6);
+    ImGui::Text("%zu frames, %.2f ms, slowest %.2f ms", frames.size(), span_ns / 1e6, slowest);
+}
+
+void draw_gpu_timings() {
+    if (!astra::g.gpu_timer) {
+        ImGui::TextDisabled("built without ASTRA_PROFILE, no GPU timings");
+        return;
+    }
+
+    // per scope name, a ring of the last HISTORY frames
+    constexpr std::size_t HISTORY = 240;
+    struct Series_ {
+        const char *name;
+        std::vector<float> ms;
+    };
+    static std::vector<Series_> series;
+    static std::size_t offset = 0;
+
+    // called once per frame while the tab is open, so one sample per frame
+    for (auto &s: series) s.ms[offset] = 0.0f;
+    for (const auto &r: astra::g.gpu_timer->results()) {
+        auto it = std::ranges::find(series, r.name, &Series_::name);
+        if (it == series.end()) it = series.insert(series.end(), {r.name, std::vector<float>(HISTORY, 0.0f)});
+        it->ms[offset] += static_cast<float>(r.ms);
+    }
+    offset = (offset + 1) % HISTORY;
+
+    for (const auto &r: astra::g.gpu_timer->results())
+        ImGui::Text("%*s%-12s %7.3f ms", static_cast<int>(r.depth * 2), "", r.name, r.ms);
+    ImGui::TextDisabled("%llu frames dropped", static_cast<unsigned long long>(astra::g.gpu_timer->dropped_frames()));
+
+    if (ImPlot::BeginPlot("##gpu", {400, ImGui::GetTextLineHeightWithSpacing() * 8}, ImPlotFlags_NoTitle)) {
+        ImPlot::SetupAxes(nullptr, "ms", ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_AutoFit);
+        ImPlot::SetupAxisLimits(ImAxis_X1, 0, HISTORY, ImPlotCond_Always);
+        for (const auto &s: series)
+            ImPlot::PlotLine(s.name, s.ms.data(), static_cast<int>(HISTORY), 1.0, 0.0, 0, static_cast<int>(offset));
+        ImPlot::EndPlot();
+    }
+}
+
+void draw_gl_counters() {
+#if defined(ASTRA_GL_COUNTERS_ENABLED)
+    const auto &c = gloo::last_frame_counters();
+    ImGui::Text("draw calls      %llu", static_cast<unsigned long long>(c.draw_calls));
+    ImGui::Text("vertices        %llu", static_cast<unsigned long long>(c.vertices));
+    ImGui::Text("state changes   %llu", static_cast<unsigned long long>(c.state_changes));
+    ImGui::Text("elided          %llu", static_cast<unsigned long long>(c.elided_calls));
+    ImGui::Text("uniform uploads %llu", static_cast<unsigned long long>(c.uniform_uploads));
+    ImGui::Text("bytes uploaded  %llu", static_cast<unsigned long long>(c.bytes_uploaded));
+    ImGui::Text("clears          %llu", static_cast<unsigned long long>(c.clears));
+#else
+    ImGui::TextDisabled("built without ASTRA_GL_COUNTERS");
+#endif
+}
+
+void draw_hermes_stats() {
+    auto enabled = astra::g.hermes->stats_enabled();
+    if (ImGui::Checkbox("record", &enabled)) astra::g.hermes->set_stats_enabled(enabled);
+    ImGui::SameLine();
+    if (ImGui::Button("Reset")) astra::g.hermes->reset_stats();
+#if !defined(ASTRA_PROFILE_ENABLED)
+    ImGui::TextDisabled("built without ASTRA_PROFILE, nothing is recorded");
+#endif
+
+    enum Column_ { Message, Subscriber, Calls, Total, Avg, Max };
+    constexpr auto flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV |
+                           ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingFixedFit;
+    if (!ImGui::BeginTable("##hermes_stats", 6, flags, {0.0f, ImGui::GetTextLineHeightWithSpacing() * 16})) return;
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Message", ImGuiTableColumnFlags_None, 0.0f, Message);
+    ImGui::TableSetupColumn("Subscriber", ImGuiTableColumnFlags_None, 0.0f, Subscriber);
+    ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_PreferSortDescending, 0.0f, Calls);
+    ImGui::TableSetupColumn(
+            "Total ms",
+            ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending,
+            0.0f,
+            Total);
+    ImGui::TableSetupColumn("Avg us", ImGuiTableColumnFlags_PreferSortDescending, 0.0f, Avg);
+    ImGui::TableSetupColumn("Max us", ImGuiTableColumnFlags_PreferSortDescending, 0.0f, Max);
+    ImGui::TableHeadersRow();
+
+    // rebuilt every frame, the numbers change every frame anyway
+    auto rows = astra::g.hermes->stats();
+    if (const auto specs = ImGui::TableGetSortSpecs(); specs && specs->SpecsCount > 0) {
+        const auto &spec = specs->Specs[0];
+        const auto avg = [](const astra::Hermes::SubscriberStats &s) {
+            return static_cast<double>(s.stats.total_ns) / static_cast<double>(s.stats.calls);
+        };
+        std::ranges::sort(rows, [&](const auto &a, const auto &b) {
+            const auto less = [&](const auto &l, const auto &r) {
+                switch (spec.ColumnUserID) {
+                case Message: return l.message < r.message;
+                case Subscriber: return l.subscriber < r.subscriber || (l.subscriber == r.subscriber && l.id < r.id);
+                case Calls: return l.stats.calls < r.stats.calls;
+                case Total: return l.stats.total_ns < r.stats.total_ns;
+                case Avg: return avg(l) < avg(r);
+                case Max: return l.stats.max_ns < r.stats.max_ns;
+                default: return false;
+                }
+            };
+            return spec.SortDirection == ImGuiSortDirection_Descending ? less(b, a) : less(a, b);
+        });
+    }
+
+    for (const auto &row: rows) {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(row.message.data(), row.message.data() + row.message.size());
+        ImGui::TableNextColumn();
+        if (row.subscriber.empty()) ImGui::TextDisabled("#%zu", row.id);
+        else ImGui::TextUnformatted(row.subscriber.data(), row.subscriber.data() + row.subscriber.size());
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(row.stats.calls));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", static_cast<double>(row.stats.total_ns) / 1e6);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.2f", static_cast<double>(row.stats.total_ns) / static_cast<double>(row.stats.calls) / 1e3);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.2f", static_cast<double>(row.stats.max_ns) / 1e3);
+    }
+    ImGui::EndTable();
 }
 
 void draw_debug_overlay() {
@@ -230,6 +647,32 @@ void draw_debug_overlay() {
                 if (ImGui::Checkbox("vsync", &vsync)) SDL_GL_SetSwapInterval(vsync ? 1 : 0);
                 ImGui::EndTabItem();
             }
+            if (ImGui::BeginTabItem("Log")) {
+                // filtered at the sink, messages below this level aren't formatted for the overlay at all
+                constexpr const char *levels[] = {"trace", "debug", "info", "warn", "error", "critical", "off"};
+                auto level = static_cast<int>(messenger_sink()->level());
+                if (ImGui::Combo("flyouts", &level, levels, IM_ARRAYSIZE(levels)))
+                    messenger_sink()->set_level(static_cast<spdlog::level::level_enum>(level));
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Profile")) {
+                if (ImGui::Button("Export trace"))
+                    astra::profile::export_chrome_trace(
+                            std::filesystem::path(".log") / fmt::format("{}.trace.json", astra::timestamp()));
+                ImGui::SeparatorText("GPU");
+                draw_gpu_timings();
+                ImGui::SeparatorText("GL calls (last frame)");
+                draw_gl_counters();
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Timeline")) {
+                draw_frame_timeline();
+                ImGui::EndTabItem();
+            }
+            if (ImGui::BeginTabItem("Hermes")) {
+                draw_hermes_stats();
+                ImGui::EndTabItem();
+            }
             if (ImGui::BeginTabItem("Shaders")) {
                 astra::g.shaders->draw_editor();
                 ImGui::EndTabItem();
@@ -243,15 +686,15 @@ void draw_debug_overlay() {
 void setup_engine_callbacks() {
     using namespace astra;
 
-    g.internal.hermes_id = g.hermes->acquire_id();
+    g.internal.hermes_id = g.hermes->acquire_id("astra");
     g.hermes->subscribe<sdl3::QuitEvent>(g.internal.hermes_id, [&](auto) { g.running = false; });
 
     g.hermes->subscribe<PreUpdate>(g.internal.hermes_id, [&](const auto *p) {
-        auto &flyouts = log_flyouts();
-        for (auto &[level, text, acc]: flyouts) acc -= p->dt;
-        while (!flyouts.empty() && flyouts.back().acc <= 0) flyouts.pop_back();
+        messenger_sink()->publish_deferred();
+
+        log_flyouts().update(p->dt);
     });
     g.hermes->subscribe<LogMessage>(g.internal.hermes_id, [&](const auto *p) {
-        log_flyouts().emplace_front(p->level, p->text, 5.0);
+        log_flyouts().push(p->level, p->text);
     });
 }
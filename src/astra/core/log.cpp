@@ -6,7 +6,11 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include <atomic>
+#include <bit>
 #include <filesystem>
+#include <thread>
+#include <vector>
 
 #if defined(ASTRA_PLATFORM_WINDOWS)
 #include <windows.h>
@@ -17,6 +21,45 @@ std::shared_ptr<spdlog::sinks::dist_sink_mt> astra::logger_sinks() {
     return s;
 }
 
+/* The logger's only sink, forwards to logger_sinks() or to the async sink
+ *
+ * The logger's own sink list never changes after creation, switching happens in here. Each message loads its own
+ * reference to the target, so a switch neither waits on a thread that's in the middle of logging nor pulls the sink
+ * out from under it.
+ */
+class FrontSink final : public spdlog::sinks::sink {
+public:
+    explicit FrontSink(spdlog::sink_ptr target) : target_(std::move(target)) {}
+
+    void log(const spdlog::details::log_msg &msg) override {
+        target_.load(std::memory_order_acquire)->log(msg);
+    }
+
+    void flush() override {
+        target_.load(std::memory_order_acquire)->flush();
+    }
+
+    void set_pattern(const std::string &pattern) override {
+        target_.load(std::memory_order_acquire)->set_pattern(pattern);
+    }
+
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override {
+        target_.load(std::memory_order_acquire)->set_formatter(std::move(sink_formatter));
+    }
+
+    void set_target(spdlog::sink_ptr target) {
+        target_.store(std::move(target), std::memory_order_release);
+    }
+
+private:
+    std::atomic<spdlog::sink_ptr> target_;
+};
+
+std::shared_ptr<FrontSink> logger_front() {
+    static auto s = std::make_shared<FrontSink>(astra::logger_sinks());
+    return s;
+}
+
 std::shared_ptr<spdlog::logger> astra::logger() {
     static auto logger = std::invoke([&] {
         auto s = logger_sinks();
@@ -32,7 +75,7 @@ std::shared_ptr<spdlog::logger> astra::logger() {
         file_sink->set_level(spdlog::level::trace);
         s->add_sink(file_sink);
 
-        auto l = std::make_shared<spdlog::logger>("astra", s);
+        auto l = std::make_shared<spdlog::logger>("astra", logger_front());
         l->set_level(spdlog::level::trace);
 
 #if defined(ASTRA_PLATFORM_WINDOWS)
@@ -44,3 +87,252 @@ std::shared_ptr<spdlog::logger> astra::logger() {
 
     return logger;
 }
+
+/* Bounded MPSC ring in front of logger_sinks() (Vyukov's queue, consumed by a single writer thread)
+ *
+ * Each slot keeps its payload buffer between uses, so once the ring has warmed up logging doesn't allocate. Producers
+ * only touch head_ and the slot they claimed, the writer publishes its progress through tail_. close() is the way
+ * out: threads already inside log() are waited for, then the writer drains the ring and is joined, and a thread that
+ * still held on to the sink logs straight downstream from then on.
+ */
+class AsyncLogSink final : public spdlog::sinks::sink {
+public:
+    AsyncLogSink(std::shared_ptr<spdlog::sinks::sink> downstream, const astra::AsyncLogOptions &options)
+        : downstream_(std::move(downstream)),
+          slots_(std::bit_ceil(std::max<std::size_t>(options.capacity, 2))),
+          mask_(slots_.size() - 1),
+          overflow_(options.overflow),
+          sample_every_(std::max<std::uint32_t>(options.sample_every, 1)) {
+        for (std::size_t i = 0; i < slots_.size(); ++i) slots_[i].sequence.store(i, std::memory_order_relaxed);
+        writer_ = std::jthread([this] { run_(); });
+    }
+
+    ~AsyncLogSink() override {
+        close();
+    }
+
+    AsyncLogSink(const AsyncLogSink &other) = delete;
+    AsyncLogSink &operator=(const AsyncLogSink &other) = delete;
+
+    AsyncLogSink(AsyncLogSink &&other) noexcept = delete;
+    AsyncLogSink &operator=(AsyncLogSink &&other) noexcept = delete;
+
+    void log(const spdlog::details::log_msg &msg) override {
+        // a downstream sink logging from the writer would wait on itself
+        if (std::this_thread::get_id() == writer_.get_id()) {
+            downstream_->log(msg);
+            return;
+        }
+
+        // seq_cst on both sides: either close() sees this thread inside, or this thread sees it closed
+        producers_.fetch_add(1);
+        if (closed_.load()) {
+            leave_();
+            drained_.wait(false); // this thread's earlier messages may still be in the ring
+            downstream_->log(msg);
+            return;
+        }
+        push_(msg);
+        leave_();
+    }
+
+    void close() {
+        if (closed_.exchange(true)) return;
+
+        for (auto inside = producers_.load(); inside != 0; inside = producers_.load()) producers_.wait(inside);
+        stopping_.store(true, std::memory_order_release);
+        wake_();
+        writer_.join();
+        drained_.store(true, std::memory_order_release);
+        drained_.notify_all();
+    }
+
+    // Waits for everything logged so far to reach the sinks
+    void flush() override {
+        if (std::this_thread::get_id() != writer_.get_id()) {
+            const auto target = head_.load(std::memory_order_acquire);
+            while (tail_.load(std::memory_order_acquire) < target) {
+                wake_();
+                std::this_thread::yield();
+            }
+        }
+        downstream_->flush();
+    }
+
+    void set_pattern(const std::string &pattern) override {
+        downstream_->set_pattern(pattern);
+    }
+
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override {
+        downstream_->set_formatter(std::move(sink_formatter));
+    }
+
+    [[nodiscard]] std::uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot_ {
+        std::atomic<std::size_t> sequence;
+        spdlog::level::level_enum level;
+        spdlog::log_clock::time_point time;
+        std::size_t thread_id;
+        spdlog::source_loc source;
+        spdlog::string_view_t logger_name; // the logger outlives the sink
+        spdlog::memory_buf_t payload;
+    };
+
+    static constexpr std::size_t BATCH_SIZE = 256;
+
+    std::shared_ptr<spdlog::sinks::sink> downstream_;
+    std::vector<Slot_> slots_;
+    std::size_t mask_;
+    astra::LogOverflow overflow_;
+    std::uint32_t sample_every_;
+
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::atomic<std::uint32_t> signal_{0};
+    std::atomic<std::uint32_t> sample_counter_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::uint64_t reported_dropped_{0};
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> closed_{false};
+    std::atomic<bool> drained_{false}; // set once the writer is joined
+    alignas(64) std::atomic<std::uint32_t> producers_{0}; // threads inside log(), close() waits for them
+
+    std::jthread writer_;
+
+    void push_(const spdlog::details::log_msg &msg) {
+        if (overflow_ == astra::LogOverflow::Sample && msg.level < spdlog::level::warn) {
+            const auto queued = head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_relaxed);
+            const auto count = sample_counter_.fetch_add(1, std::memory_order_relaxed);
+            if (queued > slots_.size() / 2 && count % sample_every_ != 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        while (!try_push_(msg)) {
+            if (overflow_ != astra::LogOverflow::Block) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            wake_();
+            std::this_thread::yield();
+        }
+        wake_();
+    }
+
+    bool try_push_(const spdlog::details::log_msg &msg) {
+        auto pos = head_.load(std::memory_order_relaxed);
+        Slot_ *slot;
+        while (true) {
+            slot = &slots_[pos & mask_];
+            const auto sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->level = msg.level;
+        slot->time = msg.time;
+        slot->thread_id = msg.thread_id;
+        slot->source = msg.source;
+        slot->logger_name = msg.logger_name;
+        slot->payload.clear();
+        slot->payload.append(msg.payload.data(), msg.payload.data() + msg.payload.size());
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop_() {
+        const auto pos = tail_.load(std::memory_order_relaxed);
+        auto &slot = slots_[pos & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+
+        auto msg = spdlog::details::log_msg(
+                slot.time,
+                slot.source,
+                slot.logger_name,
+                slot.level,
+                spdlog::string_view_t(slot.payload.data(), slot.payload.size()));
+        msg.thread_id = slot.thread_id;
+        downstream_->log(msg);
+
+        slot.sequence.store(pos + slots_.size(), std::memory_order_release);
+        tail_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    void leave_() {
+        if (producers_.fetch_sub(1) == 1 && closed_.load()) producers_.notify_all();
+    }
+
+    void wake_() {
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_one();
+    }
+
+    void report_dropped_() {
+        const auto dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped == reported_dropped_) return;
+
+        const auto text = fmt::format("Dropped {} log messages", dropped - reported_dropped_);
+        reported_dropped_ = dropped;
+        downstream_->log(spdlog::details::log_msg(spdlog::source_loc{}, "astra", spdlog::level::warn, text));
+    }
+
+    void run_() {
+        while (true) {
+            const auto signal = signal_.load(std::memory_order_acquire);
+
+            std::size_t written = 0;
+            while (try_pop_()) {
+                // flush every so often during a long burst so the file isn't far behind
+                if (++written % BATCH_SIZE == 0) downstream_->flush();
+            }
+            if (written > 0) {
+                report_dropped_();
+                downstream_->flush();
+                continue;
+            }
+
+            if (stopping_.load(std::memory_order_acquire)) break;
+            signal_.wait(signal, std::memory_order_acquire);
+        }
+    }
+};
+
+std::shared_ptr<AsyncLogSink> &async_log_sink() {
+    static std::shared_ptr<AsyncLogSink> sink;
+    return sink;
+}
+
+void astra::enable_async_logging(const AsyncLogOptions &options) {
+    if (async_log_sink()) disable_async_logging();
+
+    async_log_sink() = std::make_shared<AsyncLogSink>(logger_sinks(), options);
+    logger_front()->set_target(async_log_sink());
+    ASTRA_LOG_DEBUG("Async logging enabled (capacity={})", std::bit_ceil(std::max<std::size_t>(options.capacity, 2)));
+}
+
+void astra::disable_async_logging() {
+    if (!async_log_sink()) return;
+
+    // drain before switching back, a thread's next message mustn't reach the sinks ahead of what it already queued.
+    // Threads that log meanwhile wait for the drain and then write straight through.
+    async_log_sink()->close();
+    logger_front()->set_target(logger_sinks());
+    async_log_sink().reset();
+}
+
+std::uint64_t astra::async_log_dropped() {
+    const auto &sink = async_log_sink();
+    return sink ? sink->dropped() : 0;
+}
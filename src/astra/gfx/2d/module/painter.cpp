@@ -3,12 +3,12 @@
 astra::Painter::Painter(sdl3::Window *window)
     : window_(window) {}
 
-void astra::Painter::point(glm::vec2 p, const Color &color) {}
+void astra::Painter::point(glm::vec2 p, rgba8 color) {}
 
-void astra::Painter::line(glm::vec2 p0, glm::vec2 p1, const Color &color) {}
+void astra::Painter::line(glm::vec2 p0, glm::vec2 p1, rgba8 color) {}
 
-void astra::Painter::triangle(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, const Color &color) {}
+void astra::Painter::triangle(glm::vec2 p0, glm::vec2 p1, glm::vec2 p2, rgba8 color) {}
 
-void astra::Painter::rectangle(glm::vec2 p, glm::vec2 size, const Color &color) {}
+void astra::Painter::rectangle(glm::vec2 p, glm::vec2 size, rgba8 color) {}
 
-void astra::Painter::ellipse(glm::vec2 p, glm::vec2 size, const Color &color) {}
+void astra::Painter::ellipse(glm::vec2 p, glm::vec2 size, rgba8 color) {}
@@ -0,0 +1,158 @@
+#include "astra/gfx/atex.hpp"
+
+#include "astra/core/globals.hpp"
+#include "astra/core/log.hpp"
+#include "astra/util/module/io_service.hpp"
+
+#include <algorithm>
+#include <bit>
+
+std::uint64_t expected_mip_size(const astra::AtexFormat format, const std::uint32_t width, const std::uint32_t height) {
+    switch (format) {
+    case astra::AtexFormat::Rgba8Premultiplied: return std::uint64_t{width} * height * 4;
+    case astra::AtexFormat::Bc7Premultiplied: return std::uint64_t{(width + 3) / 4} * ((height + 3) / 4) * 16;
+    default: return 0;
+    }
+}
+
+const astra::AtexHeader &astra::AtexFile::header() const {
+    return *reinterpret_cast<const AtexHeader *>(file_.bytes().data());
+}
+
+std::span<const astra::AtexMip> astra::AtexFile::mips() const {
+    const auto p = reinterpret_cast<const AtexMip *>(file_.bytes().data() + sizeof(AtexHeader));
+    return {p, header().mip_count};
+}
+
+std::span<const std::byte> astra::AtexFile::mip_data(const std::size_t level) const {
+    const auto &mip = mips()[level];
+    return file_.bytes().subspan(mip.offset, mip.size);
+}
+
+astra::AtexFile::AtexFile(VfsFile file)
+    : file_(std::move(file)) {}
+
+std::optional<astra::AtexFile> astra::open_atex(const std::filesystem::path &path) {
+    auto file = vfs().read(path);
+    if (!file) return std::nullopt;
+    return open_atex(std::move(*file), path);
+}
+
+std::optional<astra::AtexFile> astra::open_atex(VfsFile file, const std::filesystem::path &path) {
+    const auto bytes = file.bytes();
+    if (bytes.size() < sizeof(AtexHeader)) {
+        ASTRA_LOG_ERROR("Failed to load ATEX '{}': file too small", path);
+        return std::nullopt;
+    }
+
+    const auto &header = *reinterpret_cast<const AtexHeader *>(bytes.data());
+    if (header.magic != ATEX_MAGIC) {
+        ASTRA_LOG_ERROR("Failed to load ATEX '{}': bad magic", path);
+        return std::nullopt;
+    }
+    if (header.version != ATEX_VERSION) {
+        ASTRA_LOG_ERROR("Failed to load ATEX '{}': unsupported version {}", path, header.version);
+        return std::nullopt;
+    }
+    if (header.format != AtexFormat::Rgba8Premultiplied && header.format != AtexFormat::Bc7Premultiplied) {
+        ASTRA_LOG_ERROR(
+                "Failed to load ATEX '{}': unknown format {}", path, static_cast<std::uint32_t>(header.format));
+        return std::nullopt;
+    }
+    if (header.width == 0 || header.height == 0) {
+        ASTRA_LOG_ERROR("Failed to load ATEX '{}': empty image {}x{}", path, header.width, header.height);
+        return std::nullopt;
+    }
+    // a full chain ends at 1x1, anything longer can't match the halving check below
+    const auto max_mips = static_cast<std::uint32_t>(std::bit_width(std::max(header.width, header.height)));
+    if (header.mip_count == 0 || header.mip_count > max_mips) {
+        ASTRA_LOG_ERROR("Failed to load ATEX '{}': invalid mip count {}", path, header.mip_count);
+        return std::nullopt;
+    }
+    if (bytes.size() < sizeof(AtexHeader) + header.mip_count * sizeof(AtexMip)) {
+        ASTRA_LOG_ERROR("Failed to load ATEX '{}': truncated mip index", path);
+        return std::nullopt;
+    }
+
+    const auto mips = reinterpret_cast<const AtexMip *>(bytes.data() + sizeof(AtexHeader));
+    for (std::uint32_t i = 0; i < header.mip_count; ++i) {
+        const auto &mip = mips[i];
+        // the upload trusts these dimensions to size its reads, so they have to be what the texture storage expects
+        const auto width = std::max(header.width >> i, 1u);
+        const auto height = std::max(header.height >> i, 1u);
+        if (mip.width != width || mip.height != height) {
+            ASTRA_LOG_ERROR(
+                    "Failed to load ATEX '{}': mip {} is {}x{}, expected {}x{}",
+                    path,
+                    i,
+                    mip.width,
+                    mip.height,
+                    width,
+                    height);
+            return std::nullopt;
+        }
+        if (mip.size != expected_mip_size(header.format, mip.width, mip.height)) {
+            ASTRA_LOG_ERROR("Failed to load ATEX '{}': mip {} has unexpected size {}", path, i, mip.size);
+            return std::nullopt;
+        }
+        if (mip.offset > bytes.size() || mip.size > bytes.size() - mip.offset) {
+            ASTRA_LOG_ERROR("Failed to load ATEX '{}': mip {} is out of bounds", path, i);
+            return std::nullopt;
+        }
+    }
+
+    return AtexFile(std::move(file));
+}
+
+std::unique_ptr<gloo::Texture> astra::load_atex_texture(const std::filesystem::path &path) {
+    const auto atex = open_atex(path);
+    if (!atex) return nullptr;
+    return load_atex_texture(*atex, path);
+}
+
+std::unique_ptr<gloo::Texture> astra::load_atex_texture(const AtexFile &atex, const std::filesystem::path &path) {
+    const auto &header = atex.header();
+    const auto compressed = header.format == AtexFormat::Bc7Premultiplied;
+    const auto mip_count = static_cast<GLsizei>(header.mip_count);
+
+    auto texture = gloo::TextureBuilder(GL_TEXTURE_2D)
+                           .storage(
+                                   compressed ? GL_COMPRESSED_RGBA_BPTC_UNORM : GL_RGBA8,
+                                   glm::ivec2(header.width, header.height),
+                                   mip_count)
+                           .filter(mip_count > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR, GL_LINEAR)
+                           .build();
+    if (!texture) return nullptr;
+
+    for (std::size_t i = 0; i < atex.mips().size(); ++i) {
+        const auto &mip = atex.mips()[i];
+        const auto data = atex.mip_data(i);
+        const auto size = glm::ivec2(mip.width, mip.height);
+
+        if (compressed)
+            texture->upload_compressed(static_cast<GLint>(i), size, static_cast<GLsizei>(data.size()), data.data());
+        else texture->upload(static_cast<GLint>(i), size, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+    }
+
+    ASTRA_LOG_DEBUG(
+            "Loaded ATEX '{}' ({}x{}, {} mips, id={})",
+            path,
+            header.width,
+            header.height,
+            header.mip_count,
+            texture->id);
+    return texture;
+}
+
+void astra::load_atex_texture_async(
+        const std::filesystem::path &path, std::function<void(std::unique_ptr<gloo::Texture>)> callback) {
+    g.io->read(path, [path, callback = std::move(callback)](std::optional<VfsFile> file) {
+        if (!file) {
+            callback(nullptr);
+            return;
+        }
+
+        const auto atex = open_atex(std::move(*file), path);
+        callback(atex ? load_atex_texture(*atex, path) : nullptr);
+    });
+}
@@ -0,0 +1,160 @@
+#include "astra/gfx/gradient.hpp"
+
+#include "astra/core/color_kernels.hpp"
+#include "astra/core/log.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Björn Ottosson's OKLab, from and to linear sRGB
+glm::vec4 linear_to_oklab(const glm::vec4 c) {
+    const auto l = std::cbrt(0.4122214708f * c.r + 0.5363325363f * c.g + 0.0514459929f * c.b);
+    const auto m = std::cbrt(0.2119034982f * c.r + 0.6806995451f * c.g + 0.1073969566f * c.b);
+    const auto s = std::cbrt(0.0883024619f * c.r + 0.2817188376f * c.g + 0.6299787005f * c.b);
+    return {0.2104542553f * l + 0.7936177850f * m - 0.0040720468f * s,
+            1.9779984951f * l - 2.4285922050f * m + 0.4505937099f * s,
+            0.0259040371f * l + 0.7827717662f * m - 0.8086757660f * s,
+            c.a};
+}
+
+glm::vec4 oklab_to_linear(const glm::vec4 c) {
+    const auto l_ = c[0] + 0.3963377774f * c[1] + 0.2158037573f * c[2];
+    const auto m_ = c[0] - 0.1055613458f * c[1] - 0.0638541728f * c[2];
+    const auto s_ = c[0] - 0.0894841775f * c[1] - 1.2914855480f * c[2];
+    const auto l = l_ * l_ * l_;
+    const auto m = m_ * m_ * m_;
+    const auto s = s_ * s_ * s_;
+    return {4.0767416621f * l - 3.3077115913f * m + 0.2309699292f * s,
+            -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s,
+            -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s,
+            c[3]};
+}
+
+glm::vec4 mix(const glm::vec4 a, const glm::vec4 b, const float f, const astra::Gradient::Space space) {
+    auto c = a + (b - a) * f;
+    if (space == astra::Gradient::Space::HSL) {
+        const auto delta = b[0] - a[0] - 360.0f * std::round((b[0] - a[0]) / 360.0f);
+        c[0] = a[0] + delta * f;
+        c[0] -= 360.0f * std::floor(c[0] / 360.0f);
+    }
+    return c;
+}
+
+// Written so NaN ends up at 0 instead of turning into an out of range index
+std::size_t table_index(const float t, const float scale) {
+    return static_cast<std::size_t>(std::max(0.0f, std::min(t, 1.0f)) * scale + 0.5f);
+}
+
+std::size_t cyclic_table_index(float t, const float scale) {
+    t -= std::floor(t);
+    return table_index(t, scale);
+}
+
+astra::Gradient::Gradient(const std::initializer_list<Stop> stops, const Space space, const std::size_t resolution)
+    : Gradient(std::span(stops.begin(), stops.size()), space, resolution) {}
+
+astra::Gradient::Gradient(const std::span<const Stop> stops, const Space space, std::size_t resolution) {
+    if (stops.empty()) ASTRA_LOG_ERROR("Gradient has no stops, it will be transparent black");
+    resolution = std::max<std::size_t>(resolution, 2);
+    scale_ = static_cast<float>(resolution - 1);
+
+    auto sorted = std::vector(stops.begin(), stops.end());
+    std::ranges::stable_sort(sorted, {}, &Stop::position);
+    if (sorted.empty()) sorted.push_back({0.0f, {0, 0, 0, 0}});
+
+    // stop colors into the interpolation space, all in one go
+    std::vector<glm::vec4> keys(sorted.size());
+    for (std::size_t i = 0; i < sorted.size(); ++i) keys[i] = sorted[i].color.gl_color();
+    switch (space) {
+    case Space::RGB: break;
+    case Space::HSL: color::rgb_to_hsl(keys, keys); break;
+    case Space::OKLab:
+        color::srgb_to_linear(keys, keys);
+        for (auto &k: keys) k = linear_to_oklab(k);
+        break;
+    }
+
+    std::vector<glm::vec4> colors(resolution);
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < resolution; ++i) {
+        const auto t = static_cast<float>(i) / scale_;
+        while (next < sorted.size() && sorted[next].position <= t) ++next;
+
+        if (next == 0) {
+            colors[i] = keys.front();
+        } else if (next == sorted.size()) {
+            colors[i] = keys.back();
+        } else {
+            const auto &a = sorted[next - 1];
+            const auto &b = sorted[next];
+            const auto f = b.position > a.position ? (t - a.position) / (b.position - a.position) : 0.0f;
+            colors[i] = mix(keys[next - 1], keys[next], f, space);
+        }
+    }
+
+    switch (space) {
+    case Space::RGB: break;
+    case Space::HSL: color::hsl_to_rgb(colors, colors); break;
+    case Space::OKLab:
+        for (auto &c: colors) c = oklab_to_linear(c);
+        color::linear_to_srgb(colors, colors);
+        break;
+    }
+
+    table_.resize(resolution);
+    color::pack(colors, table_);
+}
+
+astra::rgba8 astra::Gradient::sample(const float t) const {
+    return table_[table_index(t, scale_)];
+}
+
+void astra::Gradient::sample(const std::span<const float> t, const std::span<rgba8> out) const {
+    const auto n = std::min(t.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) out[i] = table_[table_index(t[i], scale_)];
+}
+
+void astra::Gradient::sample(const std::span<const float> t, const std::span<glm::vec4> out) const {
+    const auto n = std::min(t.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) out[i] = table_[table_index(t[i], scale_)].gl_color();
+}
+
+astra::rgba8 astra::Gradient::sample_cyclic(const float t, const float offset) const {
+    return table_[cyclic_table_index(t + offset, scale_)];
+}
+
+void astra::Gradient::sample_cyclic(
+        const std::span<const float> t, const float offset, const std::span<rgba8> out) const {
+    const auto n = std::min(t.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) out[i] = table_[cyclic_table_index(t[i] + offset, scale_)];
+}
+
+std::span<const astra::rgba8> astra::Gradient::table() const {
+    return table_;
+}
+
+std::size_t astra::Gradient::resolution() const {
+    return table_.size();
+}
+
+std::unique_ptr<gloo::Texture> astra::Gradient::make_texture() const {
+    auto texture = gloo::TextureBuilder(GL_TEXTURE_1D)
+                           .storage(GL_RGBA8, {static_cast<int>(table_.size()), 1})
+                           .filter(GL_LINEAR, GL_LINEAR)
+                           .wrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE)
+                           .build();
+    if (texture) upload(*texture);
+    return texture;
+}
+
+void astra::Gradient::upload(gloo::Texture &texture) const {
+    if (texture.target() != GL_TEXTURE_1D || texture.size().x != static_cast<int>(table_.size())) {
+        ASTRA_LOG_ERROR(
+                "Gradient texture mismatch (id={}, width={}, resolution={})",
+                texture.id,
+                texture.size().x,
+                table_.size());
+        return;
+    }
+    texture.upload(0, {static_cast<int>(table_.size()), 1}, GL_RGBA, GL_UNSIGNED_BYTE, table_.data());
+}
@@ -5,6 +5,7 @@
 #include "astra/core/payloads.hpp"
 #include "astra/util/io.hpp"
 #include "astra/util/module/dear.hpp"
+#include "astra/util/module/io_service.hpp"
 
 #include <ctre.hpp>
 
@@ -19,7 +20,7 @@ void ensure_newline(std::string &s) {
 }
 
 astra::ShaderMgr::ShaderMgr() {
-    hermes_id_ = g.hermes->acquire_id();
+    hermes_id_ = g.hermes->acquire_id("ShaderMgr");
     g.hermes->subscribe<PreUpdate>(hermes_id_, [&](const auto *) { sub_pending_shaders_(); });
 }
 
@@ -30,16 +31,28 @@ astra::ShaderMgr::~ShaderMgr() {
 std::shared_ptr<gloo::Shader> astra::ShaderMgr::add_shader(const std::filesystem::path &path) {
     const auto shader_src = read_parse_shader_src_(path);
     if (!shader_src) return nullptr;
+    return build_shader_(*shader_src);
+}
 
-    auto b = gloo::ShaderBuilder();
-    for (const auto &[type, src]: shader_src->stages) b.add_stage_src(type, src);
-    auto shader = b.build();
-    if (!shader) return nullptr;
+void astra::ShaderMgr::add_shader_async(
+        const std::filesystem::path &path, std::function<void(std::shared_ptr<gloo::Shader>)> callback) {
+    g.io->read(path, [this, path, callback = std::move(callback)](std::optional<VfsFile> file) {
+        if (!file) {
+            callback(nullptr);
+            return;
+        }
 
-    shader_src_.emplace(shader_src->path.string(), *shader_src);
-    shaders_.emplace(shader_src->path.string(), shader);
+        const auto contents = file->text();
 
-    return shader;
+        auto shader_src = parse_shader_src_(contents);
+        if (!shader_src) {
+            callback(nullptr);
+            return;
+        }
+
+        shader_src->path = path;
+        callback(build_shader_(*shader_src));
+    });
 }
 
 void astra::ShaderMgr::draw_editor() {
@@ -158,6 +171,18 @@ astra::ShaderMgr::parse_includes_(std::unordered_set<std::string> &deps, const s
     return result;
 }
 
+std::shared_ptr<gloo::Shader> astra::ShaderMgr::build_shader_(const ShaderSrc &shader_src) {
+    auto b = gloo::ShaderBuilder();
+    for (const auto &[type, src]: shader_src.stages) b.add_stage_src(type, src);
+    auto shader = b.build();
+    if (!shader) return nullptr;
+
+    shader_src_.emplace(shader_src.path.string(), shader_src);
+    shaders_.emplace(shader_src.path.string(), shader);
+
+    return shader;
+}
+
 void astra::ShaderMgr::try_recompile_shader_(const std::string &path, const std::string &src) {
     const auto new_shader_src = parse_shader_src_(src);
     if (!new_shader_src) {
@@ -1,5 +1,15 @@
 #include "astra/util/averagers.hpp"
 
+#include "astra/core/log.hpp"
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+void astra::Averager::update(const std::span<const double> samples) {
+    for (const auto s: samples) update(s);
+}
+
 void astra::CMA::update(double sample) {
     value_ += (sample - value_) / ++sample_count_;
 }
@@ -8,21 +18,35 @@ double astra::CMA::value() const {
     return value_;
 }
 
-astra::SMA::SMA(double sample_count)
-    : sample_count(sample_count) {}
+astra::SMA::SMA(const std::size_t sample_count)
+    : samples_(std::max<std::size_t>(sample_count, 1)) {}
 
-void astra::SMA::update(double sample) {
-    samples_.push(sample);
-    if (samples_.size() <= sample_count) {
-        value_ += (sample - value_) / samples_.size();
+void astra::SMA::update(const double sample) {
+    if (size_ < samples_.size()) {
+        ++size_;
+        sum_ += sample;
     } else {
-        value_ += (1.0 / sample_count) * (sample - samples_.front());
-        samples_.pop();
+        sum_ += sample - samples_[next_];
+    }
+    samples_[next_] = sample;
+
+    // resum once per lap so rounding error from the running sum can't build up
+    if (++next_ == samples_.size()) {
+        next_ = 0;
+        sum_ = std::accumulate(samples_.begin(), samples_.end(), 0.0);
     }
 }
 
+void astra::SMA::update(const std::span<const double> samples) {
+    for (const auto s: samples) update(s);
+}
+
 double astra::SMA::value() const {
-    return value_;
+    return size_ > 0 ? sum_ / static_cast<double>(size_) : 0.0;
+}
+
+std::size_t astra::SMA::sample_count() const {
+    return samples_.size();
 }
 
 astra::EMA::EMA(double alpha)
@@ -35,3 +59,296 @@ void astra::EMA::update(double sample) {
 double astra::EMA::value() const {
     return value_;
 }
+
+astra::SlidingVariance::SlidingVariance(const std::size_t sample_count)
+    : samples_(std::max<std::size_t>(sample_count, 1)) {}
+
+void astra::SlidingVariance::update(const double sample) {
+    if (size_ < samples_.size()) {
+        // Welford while the window fills
+        ++size_;
+        const auto delta = sample - mean_;
+        mean_ += delta / static_cast<double>(size_);
+        m2_ += delta * (sample - mean_);
+    } else {
+        // swap the oldest sample for the new one in a single step
+        const auto old = samples_[next_];
+        const auto old_mean = mean_;
+        mean_ += (sample - old) / static_cast<double>(size_);
+        m2_ += (sample - old) * (sample - mean_ + old - old_mean);
+    }
+    samples_[next_] = sample;
+
+    if (++next_ == samples_.size()) {
+        next_ = 0;
+        recompute_();
+    }
+}
+
+void astra::SlidingVariance::update(const std::span<const double> samples) {
+    for (const auto s: samples) update(s);
+}
+
+double astra::SlidingVariance::value() const {
+    return size_ > 0 ? std::max(m2_, 0.0) / static_cast<double>(size_) : 0.0;
+}
+
+double astra::SlidingVariance::mean() const {
+    return mean_;
+}
+
+double astra::SlidingVariance::stddev() const {
+    return std::sqrt(value());
+}
+
+std::size_t astra::SlidingVariance::sample_count() const {
+    return samples_.size();
+}
+
+void astra::SlidingVariance::recompute_() {
+    // two-pass over the full window once per lap, keeps the running sums honest
+    mean_ = std::accumulate(samples_.begin(), samples_.end(), 0.0) / static_cast<double>(size_);
+    m2_ = 0.0;
+    for (const auto s: samples_) m2_ += (s - mean_) * (s - mean_);
+}
+
+astra::P2Quantile::P2Quantile(const double quantile)
+    : quantile_(std::clamp(quantile, 0.0, 1.0)),
+      positions_({1.0, 2.0, 3.0, 4.0, 5.0}),
+      desired_positions_({1.0, 1.0 + 2.0 * quantile_, 1.0 + 4.0 * quantile_, 3.0 + 2.0 * quantile_, 5.0}),
+      increments_({0.0, quantile_ / 2.0, quantile_, (1.0 + quantile_) / 2.0, 1.0}) {}
+
+void astra::P2Quantile::update(const double sample) {
+    // the first five samples seed the markers directly
+    if (count_ < heights_.size()) {
+        heights_[count_++] = sample;
+        if (count_ == heights_.size()) std::ranges::sort(heights_);
+        return;
+    }
+    ++count_;
+
+    std::size_t k;
+    if (sample < heights_[0]) {
+        heights_[0] = sample;
+        k = 0;
+    } else if (sample >= heights_[4]) {
+        heights_[4] = sample;
+        k = 3;
+    } else {
+        k = 0;
+        while (sample >= heights_[k + 1]) ++k;
+    }
+
+    for (std::size_t i = k + 1; i < positions_.size(); ++i) positions_[i] += 1.0;
+    for (std::size_t i = 0; i < desired_positions_.size(); ++i) desired_positions_[i] += increments_[i];
+
+    // move the middle markers one step toward where they should be if they've drifted and there's room
+    for (std::size_t i = 1; i < 4; ++i) {
+        const auto d = desired_positions_[i] - positions_[i];
+        if ((d >= 1.0 && positions_[i + 1] - positions_[i] > 1.0) ||
+            (d <= -1.0 && positions_[i - 1] - positions_[i] < -1.0)) {
+            const auto step = d > 0.0 ? 1.0 : -1.0;
+
+            const auto h = parabolic_(i, step);
+            if (heights_[i - 1] < h && h < heights_[i + 1]) heights_[i] = h;
+            else heights_[i] = linear_(i, step);
+            positions_[i] += step;
+        }
+    }
+}
+
+void astra::P2Quantile::update(const std::span<const double> samples) {
+    for (const auto s: samples) update(s);
+}
+
+double astra::P2Quantile::value() const {
+    if (count_ == 0) return 0.0;
+    if (count_ >= heights_.size()) return heights_[2];
+
+    // not seeded yet, answer exactly from what's there
+    auto seen = heights_;
+    std::sort(seen.begin(), seen.begin() + static_cast<std::ptrdiff_t>(count_));
+    return seen[static_cast<std::size_t>(std::round(quantile_ * static_cast<double>(count_ - 1)))];
+}
+
+double astra::P2Quantile::quantile() const {
+    return quantile_;
+}
+
+std::uint64_t astra::P2Quantile::count() const {
+    return count_;
+}
+
+double astra::P2Quantile::parabolic_(const std::size_t i, const double d) const {
+    const auto &n = positions_;
+    const auto &q = heights_;
+    return q[i] + d / (n[i + 1] - n[i - 1]) *
+                          ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                           (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+}
+
+double astra::P2Quantile::linear_(const std::size_t i, const double d) const {
+    const auto j = d > 0.0 ? i + 1 : i - 1;
+    return heights_[i] + d * (heights_[j] - heights_[i]) / (positions_[j] - positions_[i]);
+}
+
+astra::DDSketch::DDSketch(const double quantile, const double relative_accuracy, const std::size_t max_bins)
+    : quantile_(std::clamp(quantile, 0.0, 1.0)),
+      relative_accuracy_(std::clamp(relative_accuracy, 1e-6, 0.5)),
+      gamma_((1.0 + relative_accuracy_) / (1.0 - relative_accuracy_)),
+      log_gamma_(std::log(gamma_)),
+      max_bins_(std::max<std::size_t>(max_bins, 1)),
+      min_(std::numeric_limits<double>::infinity()),
+      max_(-std::numeric_limits<double>::infinity()) {}
+
+void astra::DDSketch::update(const double sample) {
+    if (std::isnan(sample)) return;
+
+    if (sample > MIN_INDEXABLE) positive_.add(index_(sample), 1, max_bins_);
+    else if (sample < -MIN_INDEXABLE) negative_.add(index_(-sample), 1, max_bins_);
+    else ++zero_count_;
+
+    min_ = std::min(min_, sample);
+    max_ = std::max(max_, sample);
+}
+
+void astra::DDSketch::update(const std::span<const double> samples) {
+    for (const auto s: samples) update(s);
+}
+
+double astra::DDSketch::value() const {
+    return quantile(quantile_);
+}
+
+double astra::DDSketch::quantile(const double q) const {
+    const auto total = count();
+    if (total == 0) return 0.0;
+
+    const auto rank = static_cast<std::uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(total - 1));
+
+    // walk buckets in value order: negatives from the largest magnitude down, zero, then positives up
+    std::uint64_t seen = 0;
+    for (auto i = negative_.bins.size(); i > 0; --i) {
+        seen += negative_.bins[i - 1];
+        if (seen > rank) {
+            const auto index = negative_.offset + static_cast<std::int32_t>(i - 1);
+            return std::clamp(-bucket_value_(index), min_, max_);
+        }
+    }
+
+    seen += zero_count_;
+    if (seen > rank) return 0.0;
+
+    for (std::size_t i = 0; i < positive_.bins.size(); ++i) {
+        seen += positive_.bins[i];
+        if (seen > rank) {
+            const auto index = positive_.offset + static_cast<std::int32_t>(i);
+            return std::clamp(bucket_value_(index), min_, max_);
+        }
+    }
+
+    return max_;
+}
+
+void astra::DDSketch::merge(const DDSketch &other) {
+    if (std::abs(gamma_ - other.gamma_) > 1e-12) {
+        ASTRA_LOG_ERROR(
+                "Can't merge DDSketches with different accuracies ({} vs {})",
+                relative_accuracy_,
+                other.relative_accuracy_);
+        return;
+    }
+    if (&other == this || other.count() == 0) return;
+
+    positive_.merge(other.positive_, max_bins_);
+    negative_.merge(other.negative_, max_bins_);
+    zero_count_ += other.zero_count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void astra::DDSketch::clear() {
+    positive_ = {};
+    negative_ = {};
+    zero_count_ = 0;
+    min_ = std::numeric_limits<double>::infinity();
+    max_ = -std::numeric_limits<double>::infinity();
+}
+
+std::uint64_t astra::DDSketch::count() const {
+    return positive_.count + negative_.count + zero_count_;
+}
+
+double astra::DDSketch::min() const {
+    return count() > 0 ? min_ : 0.0;
+}
+
+double astra::DDSketch::max() const {
+    return count() > 0 ? max_ : 0.0;
+}
+
+double astra::DDSketch::relative_accuracy() const {
+    return relative_accuracy_;
+}
+
+std::int32_t astra::DDSketch::index_(const double magnitude) const {
+    return static_cast<std::int32_t>(std::ceil(std::log(magnitude) / log_gamma_));
+}
+
+double astra::DDSketch::bucket_value_(const std::int32_t index) const {
+    // the point in (gamma^(i-1), gamma^i] with the same relative error to both ends
+    return 2.0 * std::pow(gamma_, index) / (gamma_ + 1.0);
+}
+
+void astra::DDSketch::Store_::add(const std::int32_t index, const std::uint64_t n, const std::size_t max_bins) {
+    if (bins.empty()) {
+        bins.assign(1, 0);
+        offset = index;
+    } else if (index < offset) {
+        bins.insert(bins.begin(), static_cast<std::size_t>(offset - index), 0);
+        offset = index;
+    } else if (static_cast<std::size_t>(index - offset) >= bins.size()) {
+        bins.resize(static_cast<std::size_t>(index - offset) + 1, 0);
+    }
+
+    bins[static_cast<std::size_t>(index - offset)] += n;
+    count += n;
+
+    if (bins.size() > max_bins) collapse(max_bins);
+}
+
+void astra::DDSketch::Store_::merge(const Store_ &other, const std::size_t max_bins) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        *this = other;
+        collapse(max_bins);
+        return;
+    }
+
+    // grow to cover both ranges once, then add bucket by bucket
+    const auto lo = std::min(offset, other.offset);
+    const auto hi = std::max(
+            offset + static_cast<std::int32_t>(bins.size()),
+            other.offset + static_cast<std::int32_t>(other.bins.size()));
+    if (lo < offset) bins.insert(bins.begin(), static_cast<std::size_t>(offset - lo), 0);
+    bins.resize(static_cast<std::size_t>(hi - lo), 0);
+    offset = lo;
+
+    for (std::size_t i = 0; i < other.bins.size(); ++i)
+        bins[static_cast<std::size_t>(other.offset - offset) + i] += other.bins[i];
+    count += other.count;
+
+    collapse(max_bins);
+}
+
+void astra::DDSketch::Store_::collapse(const std::size_t max_bins) {
+    if (bins.size() <= max_bins) return;
+
+    // fold the lowest magnitudes into one bucket, tail latencies are the ones worth keeping exact
+    const auto excess = bins.size() - max_bins;
+    const auto end = bins.begin() + static_cast<std::ptrdiff_t>(excess);
+    const auto folded = std::accumulate(bins.begin(), end, std::uint64_t{0});
+    bins.erase(bins.begin(), end);
+    bins.front() += folded;
+    offset += static_cast<std::int32_t>(excess);
+}
@@ -2,6 +2,7 @@
 
 #include "astra/core/log.hpp"
 #include "astra/util/platform.hpp"
+#include "astra/util/vfs.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #if defined(ASTRA_PLATFORM_WINDOWS)
@@ -10,43 +11,142 @@
 #endif
 #include "stb_image.h"
 
+#if !defined(ASTRA_PLATFORM_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <cstdio>
 
-SDL_Surface *astra::read_image_to_sdl_surface(const std::filesystem::path &path) {
-    FILE *fp;
-#if defined(ASTRA_PLATFORM_WINDOWS)
-    char buffer[1024];
-    if (stbi_convert_wchar_to_utf8(buffer, 1024, path.c_str()) == 0) {
-        switch (GetLastError()) {
-        case ERROR_INSUFFICIENT_BUFFER:
-            ASTRA_LOG_ERROR("Failed to convert '{}' to UTF-8: Insufficient buffer", path);
-            break;
-        case ERROR_INVALID_FLAGS: ASTRA_LOG_ERROR("Failed to convert '{}' to UTF-8: Invalid flags", path); break;
-        case ERROR_INVALID_PARAMETER:
-            ASTRA_LOG_ERROR("Failed to convert '{}' to UTF-8: Invalid parameter", path);
-            break;
-        case ERROR_NO_UNICODE_TRANSLATION:
-            ASTRA_LOG_ERROR("Failed to convert '{}' to UTF-8: No unicode translation", path);
-            break;
-        default: std::unreachable();
-        }
-        return nullptr;
+astra::MappedFile::~MappedFile() {
+    unmap_();
+}
+
+astra::MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(other.data_),
+      size_(other.size_),
+      mapping_(other.mapping_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapping_ = nullptr;
+}
+
+astra::MappedFile &astra::MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        unmap_();
+        data_ = other.data_;
+        size_ = other.size_;
+        mapping_ = other.mapping_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapping_ = nullptr;
     }
+    return *this;
+}
+
+std::span<const std::byte> astra::MappedFile::bytes() const {
+    return {data_, size_};
+}
+
+std::size_t astra::MappedFile::size() const {
+    return size_;
+}
+
+astra::MappedFile::MappedFile(const std::byte *data, const std::size_t size, void *mapping)
+    : data_(data),
+      size_(size),
+      mapping_(mapping) {}
+
+void astra::MappedFile::unmap_() {
+#if defined(ASTRA_PLATFORM_WINDOWS)
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(mapping_);
+#else
+    if (data_) munmap(const_cast<std::byte *>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapping_ = nullptr;
+}
 
-    if (fopen_s(&fp, buffer, "rb") != 0) {
+std::optional<astra::MappedFile> astra::map_file(const std::filesystem::path &path) {
+#if defined(ASTRA_PLATFORM_WINDOWS)
+    const auto file = CreateFileW(
+            path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
         ASTRA_LOG_ERROR("Failed to open file: '{}'", path);
-        return nullptr;
+        return std::nullopt;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        ASTRA_LOG_ERROR("Failed to get size of file: '{}'", path);
+        CloseHandle(file);
+        return std::nullopt;
     }
+    if (file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return MappedFile(nullptr, 0, nullptr);
+    }
+
+    const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file); // the mapping keeps its own reference to the file
+    if (!mapping) {
+        ASTRA_LOG_ERROR("Failed to create file mapping for '{}'", path);
+        return std::nullopt;
+    }
+
+    const auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        ASTRA_LOG_ERROR("Failed to map view of file '{}'", path);
+        CloseHandle(mapping);
+        return std::nullopt;
+    }
+
+    return MappedFile(static_cast<const std::byte *>(data), static_cast<std::size_t>(file_size.QuadPart), mapping);
 #else
-    fp = fopen(path.c_str(), "rb");
-    if (!fp) {
+    const auto fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
         ASTRA_LOG_ERROR("Failed to open file: '{}'", path);
-        return nullptr;
+        return std::nullopt;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) == -1) {
+        ASTRA_LOG_ERROR("Failed to get size of file: '{}'", path);
+        close(fd);
+        return std::nullopt;
     }
+    if (st.st_size == 0) {
+        close(fd);
+        return MappedFile(nullptr, 0, nullptr);
+    }
+
+    const auto data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps its own reference to the file
+    if (data == MAP_FAILED) {
+        ASTRA_LOG_ERROR("Failed to map file '{}'", path);
+        return std::nullopt;
+    }
+
+    return MappedFile(static_cast<const std::byte *>(data), static_cast<std::size_t>(st.st_size), nullptr);
 #endif
+}
+
+SDL_Surface *astra::read_image_to_sdl_surface(const std::filesystem::path &path) {
+    const auto file = vfs().read(path);
+    if (!file) return nullptr;
 
     int w, h, channels;
-    const auto bytes = stbi_load_from_file(fp, &w, &h, &channels, STBI_rgb_alpha);
+    const auto bytes = stbi_load_from_memory(
+            reinterpret_cast<const stbi_uc *>(file->bytes().data()),
+            static_cast<int>(file->bytes().size()),
+            &w,
+            &h,
+            &channels,
+            STBI_rgb_alpha);
     if (!bytes) {
         ASTRA_LOG_ERROR("Failed to load image from '{}': {}", path, stbi_failure_reason());
         return nullptr;
@@ -58,17 +158,8 @@ SDL_Surface *astra::read_image_to_sdl_surface(const std::filesystem::path &path)
 }
 
 std::optional<std::string> astra::read_file_to_string(const std::filesystem::path &path) {
-    std::ifstream ifs(path);
-    if (!ifs.is_open()) {
-        ASTRA_LOG_ERROR("Failed to open file: '{}'", path);
-        return std::nullopt;
-    }
-
-    std::string contents;
-    ifs.seekg(0, std::ios::end);
-    contents.reserve(ifs.tellg());
-    ifs.seekg(0, std::ios::beg);
-    contents.assign(std::istreambuf_iterator(ifs), std::istreambuf_iterator<char>());
+    const auto file = vfs().read(path);
+    if (!file) return std::nullopt;
 
-    return contents;
+    return file->text();
 }
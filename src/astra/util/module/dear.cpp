@@ -72,7 +72,7 @@ astra::Dear &astra::Dear::operator=(Dear &&other) noexcept {
 }
 
 void astra::Dear::register_callbacks_() {
-    hermes_id_ = g.hermes->acquire_id();
+    hermes_id_ = g.hermes->acquire_id("Dear");
 
     g.hermes->subscribe<sdl3::RawEvent>(*hermes_id_, [&](const auto *p) {
         ImGui_ImplSDL3_ProcessEvent(&p->e);
@@ -108,6 +108,7 @@ void astra::Dear::register_callbacks_() {
 
     g.hermes->subscribe<PostDraw>(*hermes_id_, [&](const auto *) {
         ImGui::Render();
+        const gloo::GpuTimer::Scope gpu_scope(g.gpu_timer.get(), "imgui");
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
     });
 }
@@ -0,0 +1,502 @@
+#include "astra/util/module/io_service.hpp"
+
+#include "astra/core/globals.hpp"
+#include "astra/core/log.hpp"
+#include "astra/core/payloads.hpp"
+#include "astra/util/platform.hpp"
+
+#include <algorithm>
+
+#if defined(ASTRA_PLATFORM_LINUX)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+#if defined(ASTRA_PLATFORM_LINUX)
+int io_uring_setup(const unsigned entries, io_uring_params *params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter(const int fd, const unsigned to_submit, const unsigned min_complete, const unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int io_uring_register(const int fd, const unsigned opcode, void *arg, const unsigned nr_args) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// Every op the ring uses, kernels before 5.6 have io_uring but not all of these
+bool supports_ops(const int fd) {
+    constexpr std::size_t PROBE_OPS = 256;
+    std::vector<std::byte> storage(sizeof(io_uring_probe) + PROBE_OPS * sizeof(io_uring_probe_op));
+    const auto probe = reinterpret_cast<io_uring_probe *>(storage.data());
+    if (io_uring_register(fd, IORING_REGISTER_PROBE, probe, PROBE_OPS) < 0) return false;
+
+    for (const auto op: {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE}) {
+        if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) return false;
+    }
+    return true;
+}
+
+/* io_uring backend for files that resolve to disk
+ *
+ * One thread owns the ring. A file is openat, read (again on a short read) and close, each step submitted as the
+ * previous one completes, so with many files in flight a whole batch costs a few io_uring_enter calls instead of
+ * four syscalls and a page-fault mapping per file on a worker. The ring thread itself never waits on the disk: the
+ * VFS hands over the paths its mounts would try without checking them, and openat walks them in order the way
+ * Vfs::read() would. The size comes from an fstat once the file is open, its inode is in memory by then, while an
+ * IORING_OP_STATX always goes through the kernel's worker threads. New requests arrive through an eventfd that always
+ * has a read pending on the ring.
+ *
+ * Pack entries (which may need decompressing), files over MAX_FILE_SIZE (mapping beats copying there), paths none of
+ * the candidates has and anything the ring fails on go to the worker pool, which reads them through the VFS as
+ * before and logs the error if there is one. So does whatever is still queued when the ring stops, the workers
+ * empty their queue before they exit.
+ */
+struct astra::IoService::Ring_ {
+    static constexpr unsigned ENTRIES = 256;
+    static constexpr std::uint64_t MAX_FILE_SIZE = 1 << 20;
+
+    // user_data of CQEs that aren't an Op_
+    static constexpr std::uint64_t CLOSE_DATA = 0;
+    static constexpr std::uint64_t WAKE_DATA = 1;
+
+    enum class Stage_ { Open, Read };
+
+    struct Op_ {
+        Request_ request;
+        std::vector<std::filesystem::path> candidates; // openat reads the current one after submission
+        std::size_t candidate{0};
+        Stage_ stage{Stage_::Open};
+        int fd{-1};
+        std::vector<std::byte> data{};
+        std::size_t done{0};
+    };
+
+    IoService &service;
+
+    int fd{-1};
+    int wake_fd{-1};
+    std::uint64_t wake_value{0};
+
+    void *sq_ring{nullptr};
+    void *cq_ring{nullptr};
+    std::size_t sq_ring_size{0};
+    std::size_t cq_ring_size{0};
+    io_uring_sqe *sqes{nullptr};
+    std::size_t sqes_size{0};
+
+    unsigned *sq_tail{nullptr};
+    unsigned sq_mask{0};
+    unsigned *cq_head{nullptr};
+    unsigned *cq_tail{nullptr};
+    unsigned cq_mask{0};
+    io_uring_cqe *cqes{nullptr};
+
+    unsigned local_tail{0};
+    unsigned to_submit{0};
+    unsigned in_flight{0}; // SQEs whose CQE hasn't been seen, the wake read included
+
+    std::mutex mutex;
+    std::vector<Request_> incoming; // guarded by the mutex
+    std::deque<Request_> backlog{}; // waiting for room on the ring
+
+    std::jthread thread;
+
+    explicit Ring_(IoService &service) : service(service) {}
+
+    Ring_(const Ring_ &other) = delete;
+    Ring_ &operator=(const Ring_ &other) = delete;
+
+    Ring_(Ring_ &&other) noexcept = delete;
+    Ring_ &operator=(Ring_ &&other) noexcept = delete;
+
+    ~Ring_() {
+        if (thread.joinable()) {
+            thread.request_stop();
+            wake();
+            thread.join();
+        }
+
+        if (sqes) munmap(sqes, sqes_size);
+        if (cq_ring && cq_ring != sq_ring) munmap(cq_ring, cq_ring_size);
+        if (sq_ring) munmap(sq_ring, sq_ring_size);
+        if (fd != -1) close(fd);
+        if (wake_fd != -1) close(wake_fd);
+    }
+
+    static std::unique_ptr<Ring_> create(IoService &service) {
+        auto ring = std::make_unique<Ring_>(service);
+
+        io_uring_params params{};
+        ring->fd = io_uring_setup(ENTRIES, &params);
+        if (ring->fd < 0) {
+            ASTRA_LOG_DEBUG("io_uring unavailable ({}), reads use the thread pool", std::strerror(errno));
+            ring->fd = -1;
+            return nullptr;
+        }
+        if (!supports_ops(ring->fd)) {
+            ASTRA_LOG_DEBUG("io_uring lacks file ops on this kernel, reads use the thread pool");
+            return nullptr;
+        }
+
+        ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const auto single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) ring->sq_ring_size = ring->cq_ring_size = std::max(ring->sq_ring_size, ring->cq_ring_size);
+
+        const auto map = [&](const std::size_t size, const off_t offset) -> void * {
+            const auto p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, offset);
+            return p == MAP_FAILED ? nullptr : p;
+        };
+        ring->sq_ring = map(ring->sq_ring_size, IORING_OFF_SQ_RING);
+        ring->cq_ring = single_mmap ? ring->sq_ring : map(ring->cq_ring_size, IORING_OFF_CQ_RING);
+        ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        ring->sqes = static_cast<io_uring_sqe *>(map(ring->sqes_size, IORING_OFF_SQES));
+        ring->wake_fd = eventfd(0, EFD_CLOEXEC);
+        if (!ring->sq_ring || !ring->cq_ring || !ring->sqes || ring->wake_fd == -1) {
+            ASTRA_LOG_DEBUG("io_uring setup failed ({}), reads use the thread pool", std::strerror(errno));
+            return nullptr;
+        }
+
+        const auto sq = static_cast<std::byte *>(ring->sq_ring);
+        const auto cq = static_cast<std::byte *>(ring->cq_ring);
+        ring->sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        ring->sq_mask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        ring->cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        ring->cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        ring->cq_mask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        ring->cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+        // SQE i always sits in array slot i, so the array never has to be touched again
+        const auto array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        for (unsigned i = 0; i < params.sq_entries; ++i) array[i] = i;
+        ring->local_tail = *ring->sq_tail;
+
+        ring->thread = std::jthread([r = ring.get()](const std::stop_token &st) { r->run(st); });
+        return ring;
+    }
+
+    void submit(Request_ request) {
+        bool first;
+        {
+            std::lock_guard lock(mutex);
+            first = incoming.empty();
+            incoming.push_back(std::move(request));
+        }
+        // a non-empty list already has a wake on the way, a batch costs one eventfd write instead of one per file
+        if (first) wake();
+    }
+
+    void wake() const {
+        eventfd_write(wake_fd, 1);
+    }
+
+    // Room is checked by the caller, in_flight never goes past ENTRIES so the SQ can't overflow
+    io_uring_sqe &next_sqe(const std::uint64_t user_data) {
+        auto &sqe = sqes[local_tail & sq_mask];
+        sqe = {};
+        sqe.user_data = user_data;
+        ++local_tail;
+        ++to_submit;
+        ++in_flight;
+        return sqe;
+    }
+
+    void prep_wake_read() {
+        auto &sqe = next_sqe(WAKE_DATA);
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = wake_fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(&wake_value);
+        sqe.len = sizeof(wake_value);
+    }
+
+    void prep_close(const int file) {
+        auto &sqe = next_sqe(CLOSE_DATA);
+        sqe.opcode = IORING_OP_CLOSE;
+        sqe.fd = file;
+    }
+
+    void prep(Op_ *op) {
+        auto &sqe = next_sqe(reinterpret_cast<std::uint64_t>(op));
+        switch (op->stage) {
+        case Stage_::Open:
+            sqe.opcode = IORING_OP_OPENAT;
+            sqe.fd = AT_FDCWD;
+            sqe.addr = reinterpret_cast<std::uint64_t>(op->candidates[op->candidate].c_str());
+            sqe.open_flags = O_RDONLY | O_CLOEXEC;
+            break;
+        case Stage_::Read:
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = op->fd;
+            sqe.addr = reinterpret_cast<std::uint64_t>(op->data.data() + op->done);
+            sqe.len = static_cast<unsigned>(op->data.size() - op->done);
+            sqe.off = op->done;
+            break;
+        }
+    }
+
+    void start(Request_ request) {
+        auto candidates = vfs().disk_candidates(request.path);
+        if (candidates.empty()) {
+            service.submit_to_workers_(std::move(request));
+            return;
+        }
+        // owned by its CQE from here on
+        prep(new Op_{.request = std::move(request), .candidates = std::move(candidates)});
+    }
+
+    // The file isn't under this mount, read() would look at the next one too. One SQE for the CQE that got us here, so
+    // the room start() left stays the same
+    void open_next(std::unique_ptr<Op_> op) {
+        if (++op->candidate == op->candidates.size()) {
+            fall_back(std::move(op));
+            return;
+        }
+        prep(op.release());
+    }
+
+    // Hands the request to the pool, which reports the failure the same way it always has
+    void fall_back(std::unique_ptr<Op_> op) {
+        if (op->fd != -1) prep_close(op->fd);
+        service.submit_to_workers_(std::move(op->request));
+    }
+
+    void finish(std::unique_ptr<Op_> op) {
+        prep_close(op->fd);
+        op->data.resize(op->done);
+        op->request.on_read(VfsFile(std::move(op->data)));
+    }
+
+    void complete(std::unique_ptr<Op_> op, const int res) {
+        if (op->stage == Stage_::Open && (res == -ENOENT || res == -ENOTDIR)) {
+            open_next(std::move(op));
+            return;
+        }
+        if (res < 0) {
+            fall_back(std::move(op));
+            return;
+        }
+
+        switch (op->stage) {
+        case Stage_::Open: {
+            op->fd = res;
+            struct stat st{};
+            if (fstat(op->fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+                static_cast<std::uint64_t>(st.st_size) > MAX_FILE_SIZE) {
+                fall_back(std::move(op));
+                return;
+            }
+            if (st.st_size == 0) {
+                finish(std::move(op));
+                return;
+            }
+            op->data.resize(static_cast<std::size_t>(st.st_size));
+            op->stage = Stage_::Read;
+            prep(op.release());
+            return;
+        }
+
+        case Stage_::Read:
+            op->done += static_cast<std::size_t>(res);
+            // 0 means the file shrank since fstat, keep what was read
+            if (res == 0 || op->done == op->data.size()) finish(std::move(op));
+            else prep(op.release());
+            return;
+        }
+    }
+
+    void run(const std::stop_token &stop_token) {
+        prep_wake_read();
+
+        std::vector<Request_> arrived;
+        while (true) {
+            auto woken = false;
+
+            auto head = *cq_head;
+            const auto tail = std::atomic_ref(*cq_tail).load(std::memory_order_acquire);
+            for (; head != tail; ++head) {
+                const auto &cqe = cqes[head & cq_mask];
+                --in_flight;
+                if (cqe.user_data == WAKE_DATA) woken = true;
+                else if (cqe.user_data != CLOSE_DATA)
+                    complete(std::unique_ptr<Op_>(reinterpret_cast<Op_ *>(cqe.user_data)), cqe.res);
+            }
+            std::atomic_ref(*cq_head).store(head, std::memory_order_release);
+
+            const auto stopping = stop_token.stop_requested();
+            if (woken || stopping) {
+                {
+                    std::lock_guard lock(mutex);
+                    arrived.swap(incoming);
+                }
+                for (auto &r: arrived) backlog.push_back(std::move(r));
+                arrived.clear();
+                if (!stopping) prep_wake_read();
+            }
+
+            // nothing new goes on the ring, what hasn't started yet is read by the workers
+            if (stopping) {
+                for (auto &r: backlog) service.submit_to_workers_(std::move(r));
+                backlog.clear();
+            }
+
+            // leave room for the close every open eventually needs, so a CQE never has nowhere to go
+            if (!stopping) {
+                while (!backlog.empty() && in_flight + 2 <= ENTRIES) {
+                    start(std::move(backlog.front()));
+                    backlog.pop_front();
+                }
+            }
+
+            // on the way out wait for everything the kernel could still write into, the destructor's wake ends the read
+            if (stopping && in_flight == 0) return;
+
+            std::atomic_ref(*sq_tail).store(local_tail, std::memory_order_release);
+            const auto submitted = io_uring_enter(fd, to_submit, 1, IORING_ENTER_GETEVENTS);
+            if (submitted >= 0) to_submit -= static_cast<unsigned>(submitted);
+            else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                ASTRA_LOG_ERROR("io_uring_enter failed: {}", std::strerror(errno));
+                return;
+            }
+        }
+    }
+};
+#else
+struct astra::IoService::Ring_ {
+    static std::unique_ptr<Ring_> create(IoService &) {
+        return nullptr;
+    }
+
+    void submit(Request_) {}
+};
+#endif
+
+astra::IoService::IoService(std::size_t thread_count) {
+    if (thread_count == 0) thread_count = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+
+    for (std::size_t i = 0; i < thread_count; ++i)
+        workers_.emplace_back([this](const std::stop_token &st) { worker_(st); });
+    ring_ = Ring_::create(*this);
+    ASTRA_LOG_DEBUG("IoService started with {} worker(s){}", thread_count, ring_ ? " and io_uring" : "");
+
+    hermes_id_ = g.hermes->acquire_id("IoService");
+    g.hermes->subscribe<PreUpdate>(hermes_id_, [&](const auto *) { deliver_completions_(); });
+}
+
+astra::IoService::~IoService() {
+    g.hermes->release_id(hermes_id_);
+
+    ring_.reset(); // joins, and it can still hand requests to the workers until then
+
+    for (auto &w: workers_) w.request_stop();
+    request_cv_.notify_all();
+    workers_.clear(); // joins
+}
+
+void astra::IoService::read(std::filesystem::path path, Callback callback) {
+    ++pending_;
+
+    auto on_read = [this, callback = std::move(callback)](std::optional<VfsFile> file) {
+        // std::function needs to be copyable, VfsFile isn't
+        auto holder = std::make_shared<std::optional<VfsFile>>(std::move(file));
+        std::lock_guard lock(completion_mutex_);
+        completions_.emplace_back([callback, holder] { callback(std::move(*holder)); });
+        completion_cv_.notify_all();
+    };
+    submit_({std::move(path), std::move(on_read)});
+}
+
+void astra::IoService::read_batch(std::vector<std::filesystem::path> paths, BatchCallback callback) {
+    struct Batch {
+        std::vector<std::optional<VfsFile>> results;
+        std::atomic<std::size_t> remaining;
+        BatchCallback callback;
+    };
+
+    ++pending_;
+
+    const auto batch = std::make_shared<Batch>();
+    batch->results.resize(paths.size());
+    batch->remaining = paths.size();
+    batch->callback = std::move(callback);
+
+    const auto complete = [this, batch] {
+        std::lock_guard lock(completion_mutex_);
+        completions_.emplace_back([batch] { batch->callback(std::move(batch->results)); });
+        completion_cv_.notify_all();
+    };
+
+    if (paths.empty()) {
+        complete();
+        return;
+    }
+
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        auto on_read = [batch, complete, i](std::optional<VfsFile> file) {
+            batch->results[i] = std::move(file);
+            if (--batch->remaining == 0) complete();
+        };
+        submit_({std::move(paths[i]), std::move(on_read)});
+    }
+}
+
+std::size_t astra::IoService::pending() const {
+    return pending_;
+}
+
+void astra::IoService::flush() {
+    {
+        std::unique_lock lock(completion_mutex_);
+        completion_cv_.wait(lock, [&] { return completions_.size() >= pending_; });
+    }
+    deliver_completions_();
+}
+
+void astra::IoService::submit_(Request_ request) {
+    if (ring_) ring_->submit(std::move(request));
+    else submit_to_workers_(std::move(request));
+}
+
+void astra::IoService::submit_to_workers_(Request_ request) {
+    {
+        std::lock_guard lock(request_mutex_);
+        requests_.push_back(std::move(request));
+    }
+    request_cv_.notify_one();
+}
+
+void astra::IoService::worker_(const std::stop_token &stop_token) {
+    while (true) {
+        Request_ request;
+        {
+            std::unique_lock lock(request_mutex_);
+            if (!request_cv_.wait(lock, stop_token, [&] { return !requests_.empty(); })) return;
+            request = std::move(requests_.front());
+            requests_.pop_front();
+        }
+
+        request.on_read(vfs().read(request.path));
+    }
+}
+
+void astra::IoService::deliver_completions_() {
+    std::vector<std::function<void()>> completions;
+    {
+        std::lock_guard lock(completion_mutex_);
+        completions.swap(completions_);
+    }
+
+    for (auto &c: completions) {
+        c();
+        --pending_;
+    }
+}
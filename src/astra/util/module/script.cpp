@@ -0,0 +1,115 @@
+#include "astra/util/module/script.hpp"
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Free lists per 64 byte size class, carved out of 64KB chunks. Chunks are never handed back, a game that runs a few
+// thousand scripts settles on a working set quickly. Main thread only, like the TimerMgr that drives the frames.
+class FramePool {
+public:
+    void *allocate(const std::size_t size) {
+        if (size > MAX_BLOCK_SIZE) return ::operator new(size);
+
+        auto &head = free_lists_[size_class_(size)];
+        if (!head) refill_(size_class_(size));
+
+        const auto block = head;
+        head = head->next;
+        return block;
+    }
+
+    void deallocate(void *p, const std::size_t size) {
+        if (size > MAX_BLOCK_SIZE) {
+            ::operator delete(p, size);
+            return;
+        }
+
+        auto &head = free_lists_[size_class_(size)];
+        head = new (p) FreeBlock_{head};
+    }
+
+private:
+    static constexpr std::size_t GRANULARITY = 64;
+    static constexpr std::size_t MAX_BLOCK_SIZE = 4096;
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+    struct FreeBlock_ {
+        FreeBlock_ *next;
+    };
+
+    std::array<FreeBlock_ *, MAX_BLOCK_SIZE / GRANULARITY> free_lists_{};
+    std::vector<std::unique_ptr<std::byte[]>> chunks_{};
+
+    static std::size_t size_class_(const std::size_t size) {
+        return (size + GRANULARITY - 1) / GRANULARITY - 1;
+    }
+
+    void refill_(const std::size_t size_class) {
+        const auto block_size = (size_class + 1) * GRANULARITY;
+        const auto block_count = CHUNK_SIZE / block_size;
+
+        const auto chunk = chunks_.emplace_back(std::make_unique_for_overwrite<std::byte[]>(CHUNK_SIZE)).get();
+        auto &head = free_lists_[size_class];
+        for (std::size_t i = block_count; i > 0; --i) head = new (chunk + (i - 1) * block_size) FreeBlock_{head};
+    }
+};
+
+FramePool &frame_pool() {
+    static auto pool = new FramePool(); // leaked on purpose, frames can outlive static destruction order
+    return *pool;
+}
+
+astra::Script astra::Script::promise_type::get_return_object() {
+    return Script(std::coroutine_handle<promise_type>::from_promise(*this));
+}
+
+void *astra::Script::promise_type::operator new(const std::size_t size) {
+    return frame_pool().allocate(size);
+}
+
+void astra::Script::promise_type::operator delete(void *p, const std::size_t size) {
+    frame_pool().deallocate(p, size);
+}
+
+astra::Script::~Script() {
+    if (handle_) handle_.destroy();
+}
+
+astra::Script::Script(Script &&other) noexcept
+    : handle_(std::exchange(other.handle_, {})) {}
+
+astra::Script &astra::Script::operator=(Script &&other) noexcept {
+    if (this != &other) {
+        if (handle_) handle_.destroy();
+        handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+}
+
+astra::Script::Script(const std::coroutine_handle<promise_type> handle)
+    : handle_(handle) {}
+
+std::coroutine_handle<astra::Script::promise_type> astra::Script::release_() {
+    return std::exchange(handle_, {});
+}
+
+astra::WaitAwaiter::WaitAwaiter(const double seconds)
+    : seconds_(seconds) {}
+
+void astra::WaitAwaiter::await_suspend(const std::coroutine_handle<Script::promise_type> handle) const {
+    handle.promise().timers->wait_script_(handle.promise().id, seconds_);
+}
+
+void astra::NextFrameAwaiter::await_suspend(const std::coroutine_handle<Script::promise_type> handle) const {
+    handle.promise().timers->ready_script_(handle.promise().id);
+}
+
+astra::WaitAwaiter astra::wait(const double seconds) {
+    return WaitAwaiter(seconds);
+}
+
+astra::NextFrameAwaiter astra::next_frame() {
+    return {};
+}
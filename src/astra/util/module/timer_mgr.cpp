@@ -1,166 +1,461 @@
 #include "astra/util/module/timer_mgr.hpp"
 #include "astra/core/globals.hpp"
+#include "astra/core/log.hpp"
 #include "astra/core/payloads.hpp"
+#include "astra/util/module/script.hpp"
 #include "astra/util/rng.hpp"
 
-astra::TimerMgr::EveryTimer::EveryTimer(
-        std::vector<double> intervals, const std::optional<std::size_t> count, std::function<void()> callback)
-    : intervals(std::move(intervals)),
-      count(count),
-      callback(std::move(callback)) {}
-
-bool astra::TimerMgr::EveryTimer::update(double dt) {
-    acc -= dt;
-    if (acc <= 0.0) {
-        acc += intervals[rng::get<std::size_t>(intervals.size() - 1)];
-        return true;
-    }
-    return false;
-}
+#include <algorithm>
+#include <cmath>
 
-bool astra::TimerMgr::EveryTimer::fire() {
-    callback();
-    if (count) {
-        count = count.transform([](auto c) { return c > 0 ? c - 1 : c; });
-        if (*count == 0) return false;
-    }
-    return true;
+astra::TimerMgr::TimerMgr() {
+    register_callbacks_();
 }
 
-astra::TimerMgr::UntilTimer::UntilTimer(
-        std::vector<double> intervals, const std::optional<std::size_t> count, std::function<bool()> callback)
-    : intervals(std::move(intervals)),
-      count(count),
-      callback(std::move(callback)) {}
+astra::TimerMgr::~TimerMgr() {
+    clear(); // destroys script frames
+    if (hermes_id_) unregister_callbacks_();
+}
 
-bool astra::TimerMgr::UntilTimer::update(double dt) {
-    acc -= dt;
-    if (acc <= 0.0) {
-        acc += intervals[rng::get<std::size_t>(intervals.size() - 1)];
-        return true;
-    }
-    return false;
+astra::TimerMgr::TimerMgr(TimerMgr &&other) noexcept
+    : timers_(std::move(other.timers_)),
+      wheel_(std::move(other.wheel_)),
+      immediate_(std::move(other.immediate_)),
+      during_lanes_(std::move(other.during_lanes_)),
+      ready_scripts_(std::move(other.ready_scripts_)),
+      now_(other.now_),
+      tick_carry_(other.tick_carry_) {
+    other.unregister_callbacks_();
+    register_callbacks_();
+    adopt_scripts_();
 }
 
-bool astra::TimerMgr::UntilTimer::fire() {
-    bool should_continue = callback();
-    if (count) {
-        count = count.transform([](auto c) { return c > 0 ? c - 1 : c; });
-        if (*count == 0) return false;
+astra::TimerMgr &astra::TimerMgr::operator=(TimerMgr &&other) noexcept {
+    if (this != &other) {
+        clear();
+        unregister_callbacks_();
+        other.unregister_callbacks_();
+
+        timers_ = std::move(other.timers_);
+        wheel_ = std::move(other.wheel_);
+        immediate_ = std::move(other.immediate_);
+        during_lanes_ = std::move(other.during_lanes_);
+        ready_scripts_ = std::move(other.ready_scripts_);
+        now_ = other.now_;
+        tick_carry_ = other.tick_carry_;
+
+        register_callbacks_();
+        adopt_scripts_();
     }
-    return should_continue;
+    return *this;
 }
 
-astra::TimerMgr::AfterTimer::AfterTimer(double interval, std::function<void()> callback)
-    : callback(std::move(callback)),
-      acc(interval) {}
+void astra::TimerMgr::cancel(const ID id) {
+    const auto timer = timers_.get(id);
+    if (!timer) return;
 
-bool astra::TimerMgr::AfterTimer::update(double dt) {
-    acc -= dt;
-    return acc <= 0.0;
-}
+    // wheel entries are cleaned up lazily, they fail the lookup from here on
+    if (const auto lane = during_lane_(id)) remove_during_lane_(*lane);
 
-bool astra::TimerMgr::AfterTimer::fire() {
-    callback();
-    return false;
+    // erase first, destroying the frame runs destructors that could touch this TimerMgr
+    const auto coroutine = timer->coroutine;
+    timers_.erase(id);
+    if (coroutine) coroutine.destroy();
 }
 
-astra::TimerMgr::DuringTimer::DuringTimer(
-        double duration, std::function<void()> callback, std::function<void()> after_callback)
-    : callback(std::move(callback)),
-      after_callback(std::move(after_callback)),
-      acc(duration) {}
+void astra::TimerMgr::pause(const ID id) {
+    const auto timer = timers_.get(id);
+    if (!timer || timer->paused) return;
 
-bool astra::TimerMgr::DuringTimer::update(double dt) {
-    acc -= dt;
-    return true;
+    timer->paused = true;
+    if (timer->kind == Kind_::During) {
+        const auto lane = timer->lane;
+        timer->duration_left = during_lanes_.remaining[lane];
+        timer->callback = std::move(during_lanes_.callbacks[lane]);
+        timer->after_callback = std::move(during_lanes_.after_callbacks[lane]);
+        remove_during_lane_(lane);
+    } else {
+        timer->remaining = timer->deadline > now_ ? timer->deadline - now_ : 0;
+        ++timer->epoch;
+    }
 }
 
-bool astra::TimerMgr::DuringTimer::fire() {
-    callback();
-    if (acc <= 0.0) {
-        if (after_callback) after_callback();
-        return false;
+void astra::TimerMgr::resume(const ID id) {
+    const auto timer = timers_.get(id);
+    if (!timer || !timer->paused) return;
+
+    timer->paused = false;
+    if (timer->kind == Kind_::During) {
+        add_during_lane_(id, *timer, timer->duration_left);
+    } else if (timer->kind == Kind_::Script && !timer->script_on_wheel) {
+        if (std::exchange(timer->script_ready, false)) ready_scripts_.push_back(id);
+    } else {
+        timer->deadline = now_ + timer->remaining;
+        schedule_(id, *timer);
     }
-    return true;
 }
 
-astra::TimerMgr::TimerMgr() {
-    register_callbacks_();
+bool astra::TimerMgr::contains(const ID id) const {
+    return timers_.contains(id);
 }
 
-astra::TimerMgr::~TimerMgr() {
-    if (hermes_id_) unregister_callbacks_();
+std::size_t astra::TimerMgr::size() const {
+    return timers_.size();
 }
 
-astra::TimerMgr::TimerMgr(TimerMgr &&other) noexcept {
-    other.unregister_callbacks_();
-    register_callbacks_();
-}
+void astra::TimerMgr::clear() {
+    std::vector<std::coroutine_handle<>> coroutines;
+    for (const auto &timer: timers_.values())
+        if (timer.coroutine) coroutines.push_back(timer.coroutine);
 
-astra::TimerMgr &astra::TimerMgr::operator=(TimerMgr &&other) noexcept {
-    if (this != &other) {
-        unregister_callbacks_();
-        other.unregister_callbacks_();
-        register_callbacks_();
-    }
-    return *this;
-}
+    timers_.clear();
+    for (auto &level: wheel_)
+        for (auto &slot: level) slot.clear();
+    due_.clear();
+    immediate_.clear();
+    during_lanes_ = {};
+    ready_scripts_.clear();
 
-void astra::TimerMgr::cancel(const std::string &id) {
-    if (auto it = timers_.find(id); it != timers_.end()) timers_.erase(it);
+    for (const auto c: coroutines) c.destroy();
 }
 
-void astra::TimerMgr::clear() {
-    timers_.clear();
+astra::TimerMgr::ID astra::TimerMgr::run(Script script) {
+    const auto handle = script.release_();
+    if (!handle) return NULL_ID;
+
+    const auto id = timers_.emplace(Timer_{.kind = Kind_::Script});
+    timers_.get(id)->coroutine = handle;
+    handle.promise().timers = this;
+    handle.promise().id = id;
+
+    resume_script_(id);
+    return id;
 }
 
-std::string astra::TimerMgr::every_(
+astra::TimerMgr::ID astra::TimerMgr::every_(
         const std::vector<double> &intervals, std::optional<std::size_t> count, std::function<void()> callback) {
-    const auto id = rng::base58(11);
-    timers_.emplace(id, new EveryTimer(std::move(intervals), count, std::move(callback)));
+    if (intervals.empty()) {
+        ASTRA_LOG_ERROR("Timer needs at least one interval");
+        return NULL_ID;
+    }
+
+    // deadline of now, fires on the next update
+    const auto id = timers_.emplace(Timer_{.kind = Kind_::Every, .deadline = now_});
+    auto &timer = *timers_.get(id);
+    timer.intervals = to_ticks_(intervals);
+    timer.count = count;
+    timer.callback = std::move(callback);
+    schedule_(id, timer);
     return id;
 }
 
-std::string astra::TimerMgr::until_(
+astra::TimerMgr::ID astra::TimerMgr::until_(
         const std::vector<double> &intervals, std::optional<std::size_t> count, std::function<bool()> callback) {
-    const auto id = rng::base58(11);
-    timers_.emplace(id, new UntilTimer(std::move(intervals), count, std::move(callback)));
+    if (intervals.empty()) {
+        ASTRA_LOG_ERROR("Timer needs at least one interval");
+        return NULL_ID;
+    }
+
+    const auto id = timers_.emplace(Timer_{.kind = Kind_::Until, .deadline = now_});
+    auto &timer = *timers_.get(id);
+    timer.intervals = to_ticks_(intervals);
+    timer.count = count;
+    timer.until_callback = std::move(callback);
+    schedule_(id, timer);
     return id;
 }
-std::string astra::TimerMgr::after_(double interval, std::function<void()> callback) {
-    const auto id = rng::base58(11);
-    timers_.emplace(id, new AfterTimer(interval, std::move(callback)));
+
+astra::TimerMgr::ID astra::TimerMgr::after_(double interval, std::function<void()> callback) {
+    const auto id = timers_.emplace(Timer_{.kind = Kind_::After, .deadline = now_ + to_ticks_(interval)});
+    auto &timer = *timers_.get(id);
+    timer.callback = std::move(callback);
+    schedule_(id, timer);
     return id;
 }
 
-std::string
+astra::TimerMgr::ID
 astra::TimerMgr::during_(double duration, std::function<void()> callback, std::function<void()> after_callback) {
-    const auto id = rng::base58(11);
-    timers_.emplace(id, new DuringTimer(duration, std::move(callback), std::move(after_callback)));
+    const auto id = timers_.emplace(Timer_{.kind = Kind_::During});
+    auto &timer = *timers_.get(id);
+    timer.callback = std::move(callback);
+    timer.after_callback = std::move(after_callback);
+    add_during_lane_(id, timer, duration);
     return id;
 }
 
-void astra::TimerMgr::update_(double dt) {
-    for (auto it = timers_.begin(); it != timers_.end();) {
-        if (it->second->paused) {
-            ++it;
-            continue;
+std::uint64_t astra::TimerMgr::to_ticks_(const double seconds) {
+    return static_cast<std::uint64_t>(std::max(0.0, std::round(seconds * TICKS_PER_SECOND)));
+}
+
+std::vector<std::uint64_t> astra::TimerMgr::to_ticks_(const std::vector<double> &intervals) {
+    std::vector<std::uint64_t> ticks(intervals.size());
+    std::ranges::transform(intervals, ticks.begin(), [](const double i) { return to_ticks_(i); });
+    return ticks;
+}
+
+std::uint64_t astra::TimerMgr::next_interval_(const Timer_ &timer) {
+    if (timer.intervals.size() == 1) return timer.intervals[0];
+    return timer.intervals[rng::get<std::size_t>(timer.intervals.size() - 1)];
+}
+
+void astra::TimerMgr::schedule_(const ID id, Timer_ &timer) {
+    ++timer.epoch;
+    // anything already due (the first call of every/until, zero intervals, catching up after a long frame) fires on
+    // the next update rather than the next tick, a frame shorter than a tick doesn't advance the wheel. Either way a
+    // timer fires at most once per update.
+    if (timer.deadline <= now_) immediate_.push_back({id, timer.epoch});
+    else place_({id, timer.epoch}, timer.deadline);
+}
+
+void astra::TimerMgr::place_(const WheelEntry_ &entry, std::uint64_t deadline) {
+    const auto delta = deadline - now_;
+
+    for (std::size_t level = 0; level < WHEEL_LEVELS; ++level) {
+        const auto level_shift = level * WHEEL_BITS;
+        if ((delta >> level_shift) < WHEEL_SLOTS) {
+            wheel_[level][(deadline >> level_shift) & (WHEEL_SLOTS - 1)].push_back(entry);
+            return;
         }
+    }
 
-        if (it->second->update(dt)) {
-            if (!it->second->fire()) {
-                it = timers_.erase(it);
-                continue;
-            }
+    // further out than the wheel spans, park it in the last slot it can reach and it'll be re-placed on cascade
+    constexpr auto max_delta = (std::uint64_t{1} << WHEEL_LEVELS * WHEEL_BITS) - 1;
+    constexpr auto top_shift = (WHEEL_LEVELS - 1) * WHEEL_BITS;
+    deadline = now_ + max_delta;
+    wheel_[WHEEL_LEVELS - 1][(deadline >> top_shift) & (WHEEL_SLOTS - 1)].push_back(entry);
+}
+
+void astra::TimerMgr::cascade_(const std::size_t level) {
+    auto &slot = wheel_[level][(now_ >> level * WHEEL_BITS) & (WHEEL_SLOTS - 1)];
+    const auto entries = std::move(slot);
+    slot.clear();
+
+    for (const auto &e: entries) {
+        const auto timer = timers_.get(e.id);
+        if (timer && timer->epoch == e.epoch) place_(e, timer->deadline);
+    }
+}
+
+void astra::TimerMgr::advance_tick_() {
+    ++now_;
+
+    // top down, so an entry can fall more than one level in the same tick
+    for (auto level = WHEEL_LEVELS - 1; level > 0; --level)
+        if ((now_ & ((std::uint64_t{1} << level * WHEEL_BITS) - 1)) == 0) cascade_(level);
+
+    auto &slot = wheel_[0][now_ & (WHEEL_SLOTS - 1)];
+    due_.insert(due_.end(), slot.begin(), slot.end());
+    slot.clear();
+}
+
+void astra::TimerMgr::fire_(const WheelEntry_ &entry) {
+    auto timer = timers_.get(entry.id);
+    if (!timer || timer->epoch != entry.epoch || timer->paused) return;
+
+    // Callbacks are moved out while they run, they're free to create timers (which can reallocate the storage) or
+    // cancel this one
+    switch (timer->kind) {
+    case Kind_::Every: {
+        timer->deadline += next_interval_(*timer);
+        schedule_(entry.id, *timer);
+
+        auto callback = std::move(timer->callback);
+        callback();
+
+        timer = timers_.get(entry.id);
+        if (!timer) return;
+        timer->callback = std::move(callback);
+
+        if (timer->count) {
+            if (*timer->count > 0) --*timer->count;
+            if (*timer->count == 0) timers_.erase(entry.id);
+        }
+    } break;
+
+    case Kind_::Until: {
+        timer->deadline += next_interval_(*timer);
+        schedule_(entry.id, *timer);
+
+        auto callback = std::move(timer->until_callback);
+        const auto should_continue = callback();
+
+        timer = timers_.get(entry.id);
+        if (!timer) return;
+        timer->until_callback = std::move(callback);
+
+        if (timer->count) {
+            if (*timer->count > 0) --*timer->count;
+            if (*timer->count == 0) timers_.erase(entry.id);
         }
+        if (!should_continue) timers_.erase(entry.id);
+    } break;
+
+    case Kind_::After: {
+        const auto callback = std::move(timer->callback);
+        timers_.erase(entry.id);
+        callback();
+    } break;
+
+    case Kind_::Script:
+        timer->script_on_wheel = false;
+        resume_script_(entry.id);
+        break;
+
+    case Kind_::During: break; // never on the wheel
+    }
+}
+
+void astra::TimerMgr::add_during_lane_(const ID id, Timer_ &timer, const double remaining) {
+    timer.lane = during_lanes_.ids.size();
+    during_lanes_.ids.push_back(id);
+    during_lanes_.remaining.push_back(remaining);
+    during_lanes_.callbacks.push_back(std::move(timer.callback));
+    during_lanes_.after_callbacks.push_back(std::move(timer.after_callback));
+}
+
+void astra::TimerMgr::remove_during_lane_(const std::size_t lane) {
+    const auto last = during_lanes_.ids.size() - 1;
+    if (lane != last) {
+        during_lanes_.ids[lane] = during_lanes_.ids[last];
+        during_lanes_.remaining[lane] = during_lanes_.remaining[last];
+        during_lanes_.callbacks[lane] = std::move(during_lanes_.callbacks[last]);
+        during_lanes_.after_callbacks[lane] = std::move(during_lanes_.after_callbacks[last]);
+        timers_.get(during_lanes_.ids[lane])->lane = lane;
+    }
+
+    during_lanes_.ids.pop_back();
+    during_lanes_.remaining.pop_back();
+    during_lanes_.callbacks.pop_back();
+    during_lanes_.after_callbacks.pop_back();
+}
+
+std::optional<std::size_t> astra::TimerMgr::during_lane_(const ID id) const {
+    const auto timer = timers_.get(id);
+    if (!timer || timer->kind != Kind_::During || timer->paused) return std::nullopt;
+    return timer->lane;
+}
+
+void astra::TimerMgr::update_during_(const double dt) {
+    const auto count = during_lanes_.ids.size();
+    if (count == 0) return;
+
+    const auto remaining = during_lanes_.remaining.data();
+    for (std::size_t i = 0; i < count; ++i) remaining[i] -= dt;
+
+    // branchless compaction, lane indices go stale once callbacks run so keep the ids
+    during_expired_.resize(count);
+    std::size_t expired = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        during_expired_[expired] = during_lanes_.ids[i];
+        expired += remaining[i] <= 0.0;
+    }
+    during_expired_.resize(expired);
 
-        ++it;
+    // callbacks can create, cancel or pause timers (shuffling lanes), so walk a snapshot of ids. Timers created here
+    // wait for the next update.
+    during_snapshot_.assign(during_lanes_.ids.begin(), during_lanes_.ids.end());
+    for (const auto id: during_snapshot_) {
+        auto lane = during_lane_(id);
+        if (!lane) continue;
+
+        auto callback = std::move(during_lanes_.callbacks[*lane]);
+        if (callback) callback();
+
+        // a timer that paused itself took the empty slot along, its record is where resume() looks
+        if ((lane = during_lane_(id))) during_lanes_.callbacks[*lane] = std::move(callback);
+        else if (const auto timer = timers_.get(id); timer && timer->paused) timer->callback = std::move(callback);
+    }
+
+    for (const auto id: during_expired_) {
+        const auto lane = during_lane_(id);
+        if (!lane) continue;
+
+        const auto after_callback = std::move(during_lanes_.after_callbacks[*lane]);
+        remove_during_lane_(*lane);
+        timers_.erase(id);
+        if (after_callback) after_callback();
+    }
+}
+
+void astra::TimerMgr::wait_script_(const ID id, const double seconds) {
+    const auto timer = timers_.get(id);
+    if (!timer) return;
+
+    timer->deadline = now_ + to_ticks_(seconds);
+    timer->script_on_wheel = true;
+    if (!timer->paused) schedule_(id, *timer);
+    else timer->remaining = timer->deadline - now_;
+}
+
+void astra::TimerMgr::ready_script_(const ID id) {
+    const auto timer = timers_.get(id);
+    if (!timer) return;
+
+    if (timer->paused) timer->script_ready = true;
+    else ready_scripts_.push_back(id);
+}
+
+void astra::TimerMgr::resume_script_(const ID id) {
+    const auto timer = timers_.get(id);
+    if (!timer) return;
+
+    if (timer->paused) {
+        timer->script_ready = true;
+        return;
     }
+
+    // the script can create timers while it runs, don't hold on to the record
+    const auto coroutine = timer->coroutine;
+    coroutine.resume();
+
+    if (coroutine.done()) {
+        timers_.erase(id);
+        coroutine.destroy();
+    }
+}
+
+void astra::TimerMgr::update_scripts_(std::vector<ID> &ready) {
+    for (const auto id: ready) resume_script_(id);
+    ready.clear();
+    if (ready_scripts_.empty()) ready_scripts_.swap(ready);
+}
+
+void astra::TimerMgr::adopt_scripts_() {
+    for (const auto &timer: timers_.values()) {
+        if (!timer.coroutine) continue;
+        std::coroutine_handle<Script::promise_type>::from_address(timer.coroutine.address()).promise().timers = this;
+    }
+}
+
+void astra::TimerMgr::update_(double dt) {
+    // only scripts that were ready before this update started, anything that waits for the next frame from here on
+    // lands in the fresh list
+    std::vector<ID> ready_scripts;
+    ready_scripts.swap(ready_scripts_);
+
+    // scheduled before this update, so they're older than anything the wheel turns up
+    due_.insert(due_.end(), immediate_.begin(), immediate_.end());
+    immediate_.clear();
+
+    tick_carry_ += std::max(0.0, dt) * TICKS_PER_SECOND;
+    const auto ticks = static_cast<std::uint64_t>(tick_carry_);
+    tick_carry_ -= static_cast<double>(ticks);
+
+    for (std::uint64_t i = 0; i < ticks; ++i) advance_tick_();
+
+    // walk a swapped-out list, swapped back afterward so due_ keeps its capacity
+    std::vector<WheelEntry_> due;
+    due.swap(due_);
+    for (const auto &e: due) fire_(e);
+    due.clear();
+    if (due_.empty()) due_.swap(due);
+
+    update_during_(dt);
+    update_scripts_(ready_scripts);
 }
 
 void astra::TimerMgr::register_callbacks_() {
-    hermes_id_ = g.hermes->acquire_id();
+    hermes_id_ = g.hermes->acquire_id("TimerMgr");
     g.hermes->subscribe<PreUpdate>(*hermes_id_, [&](const auto *p) { update_(p->dt); });
 }
 
@@ -0,0 +1,359 @@
+#include "astra/util/module/tweener.hpp"
+
+#include "astra/core/globals.hpp"
+#include "astra/core/payloads.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+template<astra::Ease E>
+float ease_(const float t) {
+    using enum astra::Ease;
+
+    constexpr auto pi = std::numbers::pi_v<float>;
+    constexpr auto c1 = 1.70158f;
+    constexpr auto c2 = c1 * 1.525f;
+    constexpr auto c3 = c1 + 1.0f;
+
+    // InOut curves are written as selects rather than early returns so the sweep stays branch free
+    if constexpr (E == Linear) return t;
+
+    else if constexpr (E == InQuad) return t * t;
+    else if constexpr (E == OutQuad) return 1.0f - (1.0f - t) * (1.0f - t);
+    else if constexpr (E == InOutQuad) {
+        const auto u = -2.0f * t + 2.0f;
+        return t < 0.5f ? 2.0f * t * t : 1.0f - u * u / 2.0f;
+
+    } else if constexpr (E == InCubic) return t * t * t;
+    else if constexpr (E == OutCubic) {
+        const auto u = 1.0f - t;
+        return 1.0f - u * u * u;
+    } else if constexpr (E == InOutCubic) {
+        const auto u = -2.0f * t + 2.0f;
+        return t < 0.5f ? 4.0f * t * t * t : 1.0f - u * u * u / 2.0f;
+
+    } else if constexpr (E == InQuart) return t * t * t * t;
+    else if constexpr (E == OutQuart) {
+        const auto u = 1.0f - t;
+        return 1.0f - u * u * u * u;
+    } else if constexpr (E == InOutQuart) {
+        const auto u = -2.0f * t + 2.0f;
+        return t < 0.5f ? 8.0f * t * t * t * t : 1.0f - u * u * u * u / 2.0f;
+
+    } else if constexpr (E == InSine) return 1.0f - std::cos(t * pi / 2.0f);
+    else if constexpr (E == OutSine) return std::sin(t * pi / 2.0f);
+    else if constexpr (E == InOutSine) return -(std::cos(pi * t) - 1.0f) / 2.0f;
+
+    else if constexpr (E == InExpo) return t <= 0.0f ? 0.0f : std::exp2(10.0f * t - 10.0f);
+    else if constexpr (E == OutExpo) return t >= 1.0f ? 1.0f : 1.0f - std::exp2(-10.0f * t);
+    else if constexpr (E == InOutExpo) {
+        const auto v = t < 0.5f ? std::exp2(20.0f * t - 10.0f) / 2.0f : (2.0f - std::exp2(-20.0f * t + 10.0f)) / 2.0f;
+        return t <= 0.0f ? 0.0f : t >= 1.0f ? 1.0f : v;
+
+    } else if constexpr (E == InBack) return c3 * t * t * t - c1 * t * t;
+    else if constexpr (E == OutBack) {
+        const auto u = t - 1.0f;
+        return 1.0f + c3 * u * u * u + c1 * u * u;
+    } else {
+        static_assert(E == InOutBack, "unhandled easing curve");
+        const auto u = 2.0f * t;
+        const auto w = 2.0f * t - 2.0f;
+        return t < 0.5f ? u * u * ((c2 + 1.0f) * u - c2) / 2.0f : (w * w * ((c2 + 1.0f) * w + c2) + 2.0f) / 2.0f;
+    }
+}
+
+// Advance, evaluate and write every lane of one (curve, width) group, then compact the ids of the lanes that
+// finished into finished_out. Returns how many finished.
+//
+// Storing through the target pointers in the loop that evaluates the curve kept it scalar, the compiler can't rule
+// out a target aliasing the lanes. So each block of lanes is evaluated into a buffer that stays in L1 first, a loop
+// that vectorizes, and then copied out. The ids are only read for a block where something finished.
+template<astra::Ease E, std::size_t W>
+std::size_t sweep_(
+        float *progress,
+        const float *rate,
+        const float *from,
+        const float *delta,
+        float *const *targets,
+        const std::uint64_t *ids,
+        std::uint64_t *finished_out,
+        const std::size_t count,
+        const float dt) {
+    constexpr std::size_t block = 256;
+    alignas(64) std::array<float, block * W> values;
+
+    std::size_t finished = 0;
+    for (std::size_t begin = 0; begin < count; begin += block) {
+        const auto n = std::min(block, count - begin);
+        float *const p = progress + begin;
+        const float *const r = rate + begin;
+        const float *const f = from + begin * W;
+        const float *const d = delta + begin * W;
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto t = std::min(p[i] + r[i] * dt, 1.0f);
+            p[i] = t;
+            const auto e = ease_<E>(t);
+            for (std::size_t c = 0; c < W; ++c) values[i * W + c] = f[i * W + c] + d[i * W + c] * e;
+        }
+
+        for (std::size_t i = 0; i < n; ++i) std::copy_n(values.data() + i * W, W, targets[begin + i]);
+
+        // counted on its own, folded into the loop above it kept the InOut curves from vectorizing
+        std::uint32_t done = 0;
+        for (std::size_t i = 0; i < n; ++i) done += p[i] >= 1.0f;
+        if (done == 0) continue;
+        for (std::size_t i = 0; i < n; ++i) {
+            finished_out[finished] = ids[begin + i];
+            finished += p[i] >= 1.0f;
+        }
+    }
+    return finished;
+}
+
+using EaseFn = float (*)(float);
+using SweepFn = std::size_t (*)(
+        float *, const float *, const float *, const float *, float *const *, const std::uint64_t *, std::uint64_t *,
+        std::size_t, float);
+
+template<std::size_t... Is>
+constexpr auto make_ease_table(std::index_sequence<Is...>) {
+    return std::array<EaseFn, sizeof...(Is)>{&ease_<static_cast<astra::Ease>(Is)>...};
+}
+
+template<std::size_t... Is>
+constexpr auto make_sweep_table(std::index_sequence<Is...>) {
+    return std::array<std::array<SweepFn, 3>, sizeof...(Is)>{
+            {{&sweep_<static_cast<astra::Ease>(Is), 1>,
+              &sweep_<static_cast<astra::Ease>(Is), 2>,
+              &sweep_<static_cast<astra::Ease>(Is), 4>}...}};
+}
+
+constexpr auto EASE_FNS = make_ease_table(std::make_index_sequence<static_cast<std::size_t>(astra::Ease::Count)>());
+constexpr auto SWEEP_FNS = make_sweep_table(std::make_index_sequence<static_cast<std::size_t>(astra::Ease::Count)>());
+
+float astra::ease(const Ease e, const float t) {
+    return EASE_FNS[static_cast<std::size_t>(e)](std::clamp(t, 0.0f, 1.0f));
+}
+
+astra::Tweener::Tweener() {
+    register_callbacks_();
+}
+
+astra::Tweener::~Tweener() {
+    if (hermes_id_) unregister_callbacks_();
+}
+
+astra::Tweener::ID astra::Tweener::tween(
+        float &target,
+        const float to,
+        const double duration,
+        const Ease ease,
+        std::function<void()> after_callback) {
+    return add_(&target, {&target, 1}, {&to, 1}, duration, ease, std::move(after_callback));
+}
+
+astra::Tweener::ID astra::Tweener::tween(
+        glm::vec2 &target,
+        const glm::vec2 to,
+        const double duration,
+        const Ease ease,
+        std::function<void()> after_callback) {
+    const std::array from{target.x, target.y};
+    const std::array to_floats{to.x, to.y};
+    return add_(&target.x, from, to_floats, duration, ease, std::move(after_callback));
+}
+
+astra::Tweener::ID astra::Tweener::tween(
+        glm::vec4 &target,
+        const glm::vec4 to,
+        const double duration,
+        const Ease ease,
+        std::function<void()> after_callback) {
+    const std::array from{target.x, target.y, target.z, target.w};
+    const std::array to_floats{to.x, to.y, to.z, to.w};
+    return add_(&target.x, from, to_floats, duration, ease, std::move(after_callback));
+}
+
+astra::Tweener::ID astra::Tweener::tween(
+        RGB &target,
+        const RGB &to,
+        const double duration,
+        const Ease ease,
+        std::function<void()> after_callback) {
+    if (duration <= 0.0) {
+        target = to;
+        if (after_callback) after_callback();
+        return NULL_ID;
+    }
+
+    auto shadow = std::make_unique<glm::vec4>(target.r, target.g, target.b, target.a);
+    const std::array from{shadow->x, shadow->y, shadow->z, shadow->w};
+    const std::array to_floats{
+            static_cast<float>(to.r), static_cast<float>(to.g), static_cast<float>(to.b), static_cast<float>(to.a)};
+
+    const auto id = add_(&shadow->x, from, to_floats, duration, ease, std::move(after_callback));
+    const auto record = records_.get(id);
+    record->color_target = &target;
+    record->color_shadow = std::move(shadow);
+    record->color_index = color_tweens_.size();
+    color_tweens_.push_back(id);
+
+    return id;
+}
+
+void astra::Tweener::cancel(const ID id) {
+    const auto record = records_.get(id);
+    if (!record) return;
+
+    remove_lane_(*record);
+    if (record->color_target) remove_color_(*record);
+    records_.erase(id);
+}
+
+bool astra::Tweener::contains(const ID id) const {
+    return records_.contains(id);
+}
+
+std::size_t astra::Tweener::size() const {
+    return records_.size();
+}
+
+void astra::Tweener::clear() {
+    records_.clear();
+    lanes_ = {};
+    color_tweens_.clear();
+}
+
+astra::Tweener::ID astra::Tweener::add_(
+        float *target,
+        const std::span<const float> from,
+        const std::span<const float> to,
+        const double duration,
+        const Ease ease,
+        std::function<void()> after_callback) {
+    if (duration <= 0.0) {
+        std::ranges::copy(to, target);
+        if (after_callback) after_callback();
+        return NULL_ID;
+    }
+
+    const auto width_class = static_cast<std::size_t>(std::ranges::find(WIDTHS, from.size()) - WIDTHS.begin());
+    auto &lanes = lanes_[static_cast<std::size_t>(ease)][width_class];
+    const auto id = records_.emplace(Record_{.ease = ease, .width_class = width_class, .lane = lanes.ids.size()});
+
+    lanes.ids.push_back(id);
+    lanes.progress.push_back(0.0f);
+    lanes.rate.push_back(static_cast<float>(1.0 / duration));
+    for (std::size_t c = 0; c < from.size(); ++c) {
+        lanes.from.push_back(from[c]);
+        lanes.delta.push_back(to[c] - from[c]);
+    }
+    lanes.targets.push_back(target);
+    lanes.after_callbacks.push_back(std::move(after_callback));
+
+    return id;
+}
+
+void astra::Tweener::remove_lane_(const Record_ &record) {
+    auto &lanes = lanes_[static_cast<std::size_t>(record.ease)][record.width_class];
+    const auto width = WIDTHS[record.width_class];
+    const auto lane = record.lane;
+
+    const auto last = lanes.ids.size() - 1;
+    if (lane != last) {
+        lanes.ids[lane] = lanes.ids[last];
+        lanes.progress[lane] = lanes.progress[last];
+        lanes.rate[lane] = lanes.rate[last];
+        std::copy_n(lanes.from.begin() + last * width, width, lanes.from.begin() + lane * width);
+        std::copy_n(lanes.delta.begin() + last * width, width, lanes.delta.begin() + lane * width);
+        lanes.targets[lane] = lanes.targets[last];
+        lanes.after_callbacks[lane] = std::move(lanes.after_callbacks[last]);
+        records_.get(lanes.ids[lane])->lane = lane;
+    }
+
+    lanes.ids.pop_back();
+    lanes.progress.pop_back();
+    lanes.rate.pop_back();
+    lanes.from.resize(lanes.from.size() - width);
+    lanes.delta.resize(lanes.delta.size() - width);
+    lanes.targets.pop_back();
+    lanes.after_callbacks.pop_back();
+}
+
+void astra::Tweener::remove_color_(const Record_ &record) {
+    const auto last = color_tweens_.size() - 1;
+    if (record.color_index != last) {
+        color_tweens_[record.color_index] = color_tweens_[last];
+        records_.get(color_tweens_[record.color_index])->color_index = record.color_index;
+    }
+    color_tweens_.pop_back();
+}
+
+void astra::Tweener::write_colors_() {
+    const auto to_u8 = [](const float v) { return static_cast<std::uint8_t>(std::clamp(std::round(v), 0.0f, 255.0f)); };
+
+    for (const auto id: color_tweens_) {
+        const auto record = records_.get(id);
+        const auto &shadow = *record->color_shadow;
+        record->color_target->r = to_u8(shadow.x);
+        record->color_target->g = to_u8(shadow.y);
+        record->color_target->b = to_u8(shadow.z);
+        record->color_target->a = to_u8(shadow.w);
+    }
+}
+
+void astra::Tweener::update_(const float dt) {
+    finished_.resize(records_.size());
+    std::size_t finished = 0;
+
+    for (std::size_t e = 0; e < EASE_COUNT; ++e) {
+        for (std::size_t w = 0; w < WIDTHS.size(); ++w) {
+            auto &lanes = lanes_[e][w];
+            if (lanes.ids.empty()) continue;
+
+            finished += SWEEP_FNS[e][w](
+                    lanes.progress.data(),
+                    lanes.rate.data(),
+                    lanes.from.data(),
+                    lanes.delta.data(),
+                    lanes.targets.data(),
+                    lanes.ids.data(),
+                    finished_.data() + finished,
+                    lanes.ids.size(),
+                    dt);
+        }
+    }
+    finished_.resize(finished);
+
+    write_colors_();
+
+    if (finished_.empty()) return;
+
+    // remove everything first, the callbacks are free to start or cancel tweens
+    for (const auto id: finished_) {
+        const auto record = records_.get(id);
+        auto &lanes = lanes_[static_cast<std::size_t>(record->ease)][record->width_class];
+        if (auto &callback = lanes.after_callbacks[record->lane]) finished_callbacks_.push_back(std::move(callback));
+
+        remove_lane_(*record);
+        if (record->color_target) remove_color_(*record);
+        records_.erase(id);
+    }
+
+    auto callbacks = std::move(finished_callbacks_);
+    finished_callbacks_.clear();
+    for (const auto &c: callbacks) c();
+}
+
+void astra::Tweener::register_callbacks_() {
+    hermes_id_ = g.hermes->acquire_id("Tweener");
+    g.hermes->subscribe<PreUpdate>(*hermes_id_, [&](const auto *p) { update_(static_cast<float>(p->dt)); });
+}
+
+void astra::Tweener::unregister_callbacks_() {
+    g.hermes->release_id(*hermes_id_);
+    hermes_id_ = std::nullopt;
+}
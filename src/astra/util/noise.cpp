@@ -0,0 +1,311 @@
+#include "astra/util/noise.hpp"
+
+#include "astra/util/rng.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+// Output scales that bring each kind to roughly [-1, 1], measured over many samples
+constexpr float PERLIN_2D_SCALE = 0.65f;
+constexpr float PERLIN_3D_SCALE = 1.0f;
+constexpr float SIMPLEX_2D_SCALE = 45.0f;
+constexpr float SIMPLEX_3D_SCALE = 32.0f;
+
+// murmur3 finalizer over the lattice coordinates, stands in for a permutation table
+inline std::uint32_t hash(const std::int32_t x, const std::int32_t y, const std::int32_t z, const std::uint32_t seed) {
+    auto h = seed ^ static_cast<std::uint32_t>(x) * 0x8da6b343u ^ static_cast<std::uint32_t>(y) * 0xd8163841u ^
+             static_cast<std::uint32_t>(z) * 0xcb1ab31fu;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+inline std::int32_t floor_int(const float x) {
+    const auto i = static_cast<std::int32_t>(x);
+    return i - static_cast<std::int32_t>(x < static_cast<float>(i));
+}
+
+inline float fade(const float t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+inline float lerp(const float a, const float b, const float t) {
+    return a + (b - a) * t;
+}
+
+inline float lattice_value(const std::uint32_t h) {
+    return static_cast<float>(h >> 8) * 0x1.0p-23f - 1.0f;
+}
+
+// Gradients come from tables rather than branches on the hash bits, which are random and would always mispredict
+
+// 8 directions, (±1, ±2) and (±2, ±1)
+constexpr std::array<float, 8> GRAD2_X{2.0f, 2.0f, -2.0f, -2.0f, 1.0f, -1.0f, 1.0f, -1.0f};
+constexpr std::array<float, 8> GRAD2_Y{1.0f, -1.0f, 1.0f, -1.0f, 2.0f, 2.0f, -2.0f, -2.0f};
+
+// the 12 cube edge directions of improved Perlin noise, with 4 repeated to fill 16
+constexpr std::array<float, 16> GRAD3_X{1, -1, 1, -1, 1, -1, 1, -1, 0, 0, 0, 0, 1, 0, -1, 0};
+constexpr std::array<float, 16> GRAD3_Y{1, 1, -1, -1, 0, 0, 0, 0, 1, -1, 1, -1, 1, -1, 1, -1};
+constexpr std::array<float, 16> GRAD3_Z{0, 0, 0, 0, 1, 1, -1, -1, 1, 1, -1, -1, 0, 1, 0, -1};
+
+inline float grad(const std::uint32_t h, const float x, const float y) {
+    const auto i = h & 7;
+    return GRAD2_X[i] * x + GRAD2_Y[i] * y;
+}
+
+inline float grad(const std::uint32_t h, const float x, const float y, const float z) {
+    const auto i = h & 15;
+    return GRAD3_X[i] * x + GRAD3_Y[i] * y + GRAD3_Z[i] * z;
+}
+
+inline float value_noise(const glm::vec2 p, const std::uint32_t seed) {
+    const auto x0 = floor_int(p.x);
+    const auto y0 = floor_int(p.y);
+    const auto tx = fade(p.x - static_cast<float>(x0));
+    const auto ty = fade(p.y - static_cast<float>(y0));
+
+    const auto a = lerp(lattice_value(hash(x0, y0, 0, seed)), lattice_value(hash(x0 + 1, y0, 0, seed)), tx);
+    const auto b = lerp(lattice_value(hash(x0, y0 + 1, 0, seed)), lattice_value(hash(x0 + 1, y0 + 1, 0, seed)), tx);
+    return lerp(a, b, ty);
+}
+
+inline float value_noise(const glm::vec3 p, const std::uint32_t seed) {
+    const auto x0 = floor_int(p.x);
+    const auto y0 = floor_int(p.y);
+    const auto z0 = floor_int(p.z);
+    const auto tx = fade(p.x - static_cast<float>(x0));
+    const auto ty = fade(p.y - static_cast<float>(y0));
+    const auto tz = fade(p.z - static_cast<float>(z0));
+
+    const auto v = [&](const std::int32_t dx, const std::int32_t dy, const std::int32_t dz) {
+        return lattice_value(hash(x0 + dx, y0 + dy, z0 + dz, seed));
+    };
+    const auto a = lerp(lerp(v(0, 0, 0), v(1, 0, 0), tx), lerp(v(0, 1, 0), v(1, 1, 0), tx), ty);
+    const auto b = lerp(lerp(v(0, 0, 1), v(1, 0, 1), tx), lerp(v(0, 1, 1), v(1, 1, 1), tx), ty);
+    return lerp(a, b, tz);
+}
+
+inline float perlin_noise(const glm::vec2 p, const std::uint32_t seed) {
+    const auto x0 = floor_int(p.x);
+    const auto y0 = floor_int(p.y);
+    const auto fx = p.x - static_cast<float>(x0);
+    const auto fy = p.y - static_cast<float>(y0);
+    const auto tx = fade(fx);
+    const auto ty = fade(fy);
+
+    const auto a = lerp(grad(hash(x0, y0, 0, seed), fx, fy), grad(hash(x0 + 1, y0, 0, seed), fx - 1.0f, fy), tx);
+    const auto b = lerp(
+            grad(hash(x0, y0 + 1, 0, seed), fx, fy - 1.0f),
+            grad(hash(x0 + 1, y0 + 1, 0, seed), fx - 1.0f, fy - 1.0f),
+            tx);
+    return lerp(a, b, ty) * PERLIN_2D_SCALE;
+}
+
+inline float perlin_noise(const glm::vec3 p, const std::uint32_t seed) {
+    const auto x0 = floor_int(p.x);
+    const auto y0 = floor_int(p.y);
+    const auto z0 = floor_int(p.z);
+    const auto fx = p.x - static_cast<float>(x0);
+    const auto fy = p.y - static_cast<float>(y0);
+    const auto fz = p.z - static_cast<float>(z0);
+    const auto tx = fade(fx);
+    const auto ty = fade(fy);
+    const auto tz = fade(fz);
+
+    const auto g = [&](const std::int32_t dx, const std::int32_t dy, const std::int32_t dz) {
+        const auto h = hash(x0 + dx, y0 + dy, z0 + dz, seed);
+        return grad(h, fx - static_cast<float>(dx), fy - static_cast<float>(dy), fz - static_cast<float>(dz));
+    };
+    const auto a = lerp(lerp(g(0, 0, 0), g(1, 0, 0), tx), lerp(g(0, 1, 0), g(1, 1, 0), tx), ty);
+    const auto b = lerp(lerp(g(0, 0, 1), g(1, 0, 1), tx), lerp(g(0, 1, 1), g(1, 1, 1), tx), ty);
+    return lerp(a, b, tz) * PERLIN_3D_SCALE;
+}
+
+inline float simplex_noise(const glm::vec2 p, const std::uint32_t seed) {
+    constexpr auto F2 = 0.36602540378f; // (sqrt(3) - 1) / 2
+    constexpr auto G2 = 0.21132486540f; // (3 - sqrt(3)) / 6
+
+    const auto s = (p.x + p.y) * F2;
+    const auto i = floor_int(p.x + s);
+    const auto j = floor_int(p.y + s);
+    const auto t = static_cast<float>(i + j) * G2;
+    const auto x0 = p.x - (static_cast<float>(i) - t);
+    const auto y0 = p.y - (static_cast<float>(j) - t);
+
+    // which of the two triangles in the skewed cell
+    const auto i1 = static_cast<std::int32_t>(x0 > y0);
+    const auto j1 = 1 - i1;
+
+    const auto x1 = x0 - static_cast<float>(i1) + G2;
+    const auto y1 = y0 - static_cast<float>(j1) + G2;
+    const auto x2 = x0 - 1.0f + 2.0f * G2;
+    const auto y2 = y0 - 1.0f + 2.0f * G2;
+
+    const auto corner = [&](const std::uint32_t h, const float x, const float y) {
+        auto c = std::max(0.5f - x * x - y * y, 0.0f);
+        c *= c;
+        return c * c * grad(h, x, y);
+    };
+    const auto n = corner(hash(i, j, 0, seed), x0, y0) + corner(hash(i + i1, j + j1, 0, seed), x1, y1) +
+                   corner(hash(i + 1, j + 1, 0, seed), x2, y2);
+    return n * SIMPLEX_2D_SCALE;
+}
+
+inline float simplex_noise(const glm::vec3 p, const std::uint32_t seed) {
+    constexpr auto F3 = 1.0f / 3.0f;
+    constexpr auto G3 = 1.0f / 6.0f;
+
+    const auto s = (p.x + p.y + p.z) * F3;
+    const auto i = floor_int(p.x + s);
+    const auto j = floor_int(p.y + s);
+    const auto k = floor_int(p.z + s);
+    const auto t = static_cast<float>(i + j + k) * G3;
+    const auto x0 = p.x - (static_cast<float>(i) - t);
+    const auto y0 = p.y - (static_cast<float>(j) - t);
+    const auto z0 = p.z - (static_cast<float>(k) - t);
+
+    // which of the six tetrahedra, from the rank order of the offsets, without branching
+    const auto xy = static_cast<std::int32_t>(x0 >= y0);
+    const auto xz = static_cast<std::int32_t>(x0 >= z0);
+    const auto yz = static_cast<std::int32_t>(y0 >= z0);
+    const auto i1 = xy & xz;
+    const auto j1 = (1 - xy) & yz;
+    const auto k1 = (1 - xz) & (1 - yz);
+    const auto i2 = xy | xz;
+    const auto j2 = (1 - xy) | yz;
+    const auto k2 = (1 - xz) | (1 - yz);
+
+    const auto corner = [&](const std::int32_t di, const std::int32_t dj, const std::int32_t dk, const float offset) {
+        const auto x = x0 - static_cast<float>(di) + offset;
+        const auto y = y0 - static_cast<float>(dj) + offset;
+        const auto z = z0 - static_cast<float>(dk) + offset;
+        auto c = std::max(0.6f - x * x - y * y - z * z, 0.0f);
+        c *= c;
+        return c * c * grad(hash(i + di, j + dj, k + dk, seed), x, y, z);
+    };
+    const auto n = corner(0, 0, 0, 0.0f) + corner(i1, j1, k1, G3) + corner(i2, j2, k2, 2.0f * G3) +
+                   corner(1, 1, 1, 3.0f * G3);
+    return n * SIMPLEX_3D_SCALE;
+}
+
+template<astra::noise::Kind K, typename P>
+float kernel(const P p, const std::uint32_t seed) {
+    if constexpr (K == astra::noise::Kind::Value) return value_noise(p, seed);
+    else if constexpr (K == astra::noise::Kind::Perlin) return perlin_noise(p, seed);
+    else return simplex_noise(p, seed);
+}
+
+/* One pass over all points per octave, so the inner loop is a single kernel over contiguous output that the compiler
+ * can vectorize. point_at(i) produces the i-th point, either from a span or computed for a grid.
+ */
+template<astra::noise::Kind K, typename PointAt>
+void sample_batch(
+        const std::size_t count, PointAt &&point_at, const std::span<float> out, const astra::noise::Params &params) {
+    if (params.octaves <= 1) {
+        for (std::size_t i = 0; i < count; ++i) out[i] = kernel<K>(point_at(i) * params.frequency, params.seed);
+        return;
+    }
+
+    std::fill_n(out.begin(), count, 0.0f);
+
+    auto frequency = params.frequency;
+    auto amplitude = 1.0f;
+    auto total = 0.0f;
+    for (int octave = 0; octave < params.octaves; ++octave) {
+        const auto seed = params.seed + static_cast<std::uint32_t>(octave) * 0x9e3779b9u; // decorrelate octaves
+        for (std::size_t i = 0; i < count; ++i) out[i] += amplitude * kernel<K>(point_at(i) * frequency, seed);
+
+        total += amplitude;
+        amplitude *= params.gain;
+        frequency *= params.lacunarity;
+    }
+
+    const auto norm = 1.0f / total;
+    for (std::size_t i = 0; i < count; ++i) out[i] *= norm;
+}
+
+template<typename PointAt>
+void dispatch(
+        const std::size_t count, PointAt &&point_at, const std::span<float> out, const astra::noise::Params &params) {
+    switch (params.kind) {
+    case astra::noise::Kind::Value: sample_batch<astra::noise::Kind::Value>(count, point_at, out, params); break;
+    case astra::noise::Kind::Perlin: sample_batch<astra::noise::Kind::Perlin>(count, point_at, out, params); break;
+    case astra::noise::Kind::Simplex: sample_batch<astra::noise::Kind::Simplex>(count, point_at, out, params); break;
+    }
+}
+
+std::uint32_t astra::noise::default_seed() {
+    const auto key = rng::stream_key();
+    return static_cast<std::uint32_t>(key) ^ static_cast<std::uint32_t>(key >> 32);
+}
+
+float astra::noise::value(const glm::vec2 p, const std::uint32_t seed) {
+    return value_noise(p, seed);
+}
+
+float astra::noise::value(const glm::vec3 p, const std::uint32_t seed) {
+    return value_noise(p, seed);
+}
+
+float astra::noise::perlin(const glm::vec2 p, const std::uint32_t seed) {
+    return perlin_noise(p, seed);
+}
+
+float astra::noise::perlin(const glm::vec3 p, const std::uint32_t seed) {
+    return perlin_noise(p, seed);
+}
+
+float astra::noise::simplex(const glm::vec2 p, const std::uint32_t seed) {
+    return simplex_noise(p, seed);
+}
+
+float astra::noise::simplex(const glm::vec3 p, const std::uint32_t seed) {
+    return simplex_noise(p, seed);
+}
+
+float astra::noise::sample(const glm::vec2 p, const Params &params) {
+    auto result = 0.0f;
+    dispatch(1, [&](std::size_t) { return p; }, std::span(&result, 1), params);
+    return result;
+}
+
+float astra::noise::sample(const glm::vec3 p, const Params &params) {
+    auto result = 0.0f;
+    dispatch(1, [&](std::size_t) { return p; }, std::span(&result, 1), params);
+    return result;
+}
+
+void astra::noise::sample(
+        const std::span<const glm::vec2> points, const std::span<float> out, const Params &params) {
+    dispatch(points.size(), [&](const std::size_t i) { return points[i]; }, out, params);
+}
+
+void astra::noise::sample(
+        const std::span<const glm::vec3> points, const std::span<float> out, const Params &params) {
+    dispatch(points.size(), [&](const std::size_t i) { return points[i]; }, out, params);
+}
+
+void astra::noise::sample_grid(
+        const glm::ivec2 size,
+        const glm::vec2 origin,
+        const glm::vec2 step,
+        const std::span<float> out,
+        const Params &params) {
+    if (size.x <= 0 || size.y <= 0) return;
+
+    // row by row, so the point for an index is a multiply-add instead of a division
+    const auto width = static_cast<std::size_t>(size.x);
+    for (std::int32_t y = 0; y < size.y; ++y) {
+        const auto row_y = origin.y + step.y * static_cast<float>(y);
+        const auto row = out.subspan(static_cast<std::size_t>(y) * width, width);
+        dispatch(
+                width,
+                [&](const std::size_t x) { return glm::vec2(origin.x + step.x * static_cast<float>(x), row_y); },
+                row,
+                params);
+    }
+}
@@ -0,0 +1,174 @@
+#include "astra/util/profile.hpp"
+
+#include "astra/core/log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+
+struct ProfileRegistry {
+    std::mutex mutex;
+    // threads that have exited keep their zones until reused
+    std::vector<std::shared_ptr<astra::profile::detail::ThreadRing>> rings;
+    // rings of exited threads, handed to the next new thread
+    std::vector<std::shared_ptr<astra::profile::detail::ThreadRing>> retired;
+    std::uint32_t next_index{0};
+};
+
+ProfileRegistry &registry() {
+    static ProfileRegistry r;
+    return r;
+}
+
+std::shared_ptr<astra::profile::detail::ThreadRing> register_thread() {
+    auto &r = registry();
+    std::lock_guard lock(r.mutex);
+
+    std::shared_ptr<astra::profile::detail::ThreadRing> ring;
+    if (r.retired.empty()) {
+        ring = std::make_shared<astra::profile::detail::ThreadRing>();
+        r.rings.push_back(ring);
+    } else {
+        // the exited thread's zones go, collect() can't be reading them while we hold the lock
+        ring = std::move(r.retired.back());
+        r.retired.pop_back();
+        ring->written.store(0, std::memory_order_relaxed);
+        ring->depth = 0;
+    }
+
+    ring->thread_index = r.next_index++;
+    ring->thread_name = fmt::format("thread {}", ring->thread_index);
+    return ring;
+}
+
+// Owned by a thread_local, so a thread that exits gives its ring back
+struct ThreadRingHandle {
+    std::shared_ptr<astra::profile::detail::ThreadRing> ring{register_thread()};
+
+    ~ThreadRingHandle() {
+        auto &r = registry();
+        std::lock_guard lock(r.mutex);
+        r.retired.push_back(std::move(ring));
+    }
+};
+
+void append_json_string(fmt::memory_buffer &out, const std::string_view s) {
+    out.push_back('"');
+    for (const auto c: s) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        if (static_cast<unsigned char>(c) < 0x20)
+            fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+        else out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+astra::profile::detail::ThreadRing &astra::profile::detail::thread_ring() {
+    thread_local const ThreadRingHandle handle;
+    return *handle.ring;
+}
+
+std::int64_t astra::profile::detail::now_ns() {
+    const auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+}
+
+void astra::profile::set_thread_name(std::string name) {
+#if defined(ASTRA_PROFILE_ENABLED)
+    auto &ring = detail::thread_ring();
+    std::lock_guard lock(registry().mutex);
+    ring.thread_name = std::move(name);
+#else
+    static_cast<void>(name); // no ring for a thread that will never record
+#endif
+}
+
+std::vector<astra::profile::ThreadZones> astra::profile::collect() {
+    std::vector<ThreadZones> result;
+
+    auto &r = registry();
+    std::lock_guard lock(r.mutex);
+    for (const auto &ring: r.rings) {
+        auto &tz = result.emplace_back(ring->thread_index, ring->thread_name, std::vector<Zone>{});
+
+        const auto written = ring->written.load(std::memory_order_acquire);
+        const auto first = written > PROFILE_RING_SIZE ? written - PROFILE_RING_SIZE : 0;
+        tz.zones.reserve(written - first);
+        for (auto i = first; i < written; ++i) {
+            const auto &slot = ring->slots[i & (PROFILE_RING_SIZE - 1)];
+            tz.zones.push_back(
+                    {slot.name.load(std::memory_order_relaxed),
+                     slot.begin_ns.load(std::memory_order_relaxed),
+                     slot.end_ns.load(std::memory_order_relaxed),
+                     slot.depth.load(std::memory_order_relaxed)});
+        }
+
+        // the owner kept going while we copied, anything it may have lapped (or be writing over) is dropped. The fence
+        // keeps the slot loads above from being reordered past this one
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto after = ring->written.load(std::memory_order_acquire);
+        if (after + 1 > first + PROFILE_RING_SIZE) {
+            const auto lapped = std::min<std::size_t>(after + 1 - first - PROFILE_RING_SIZE, tz.zones.size());
+            tz.zones.erase(tz.zones.begin(), tz.zones.begin() + static_cast<std::ptrdiff_t>(lapped));
+        }
+    }
+
+    return result;
+}
+
+bool astra::profile::export_chrome_trace(const std::filesystem::path &path) {
+    return export_chrome_trace(path, collect());
+}
+
+bool astra::profile::export_chrome_trace(
+        const std::filesystem::path &path, const std::span<const ThreadZones> threads) {
+    auto origin = std::numeric_limits<std::int64_t>::max();
+    for (const auto &t: threads)
+        for (const auto &z: t.zones) origin = std::min(origin, z.begin_ns);
+
+    fmt::memory_buffer out;
+    fmt::format_to(std::back_inserter(out), "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    auto first = true;
+    const auto separator = [&] {
+        if (!first) out.push_back(',');
+        first = false;
+    };
+
+    std::size_t count = 0;
+    for (const auto &t: threads) {
+        separator();
+        fmt::format_to(
+                std::back_inserter(out),
+                "\n{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":",
+                t.thread_index);
+        append_json_string(out, t.thread_name);
+        fmt::format_to(std::back_inserter(out), "}}}}");
+
+        for (const auto &z: t.zones) {
+            separator();
+            fmt::format_to(std::back_inserter(out), "\n{{\"ph\":\"X\",\"name\":");
+            append_json_string(out, z.name ? z.name : "?");
+            fmt::format_to(
+                    std::back_inserter(out),
+                    ",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                    t.thread_index,
+                    static_cast<double>(z.begin_ns - origin) / 1000.0,
+                    static_cast<double>(z.end_ns - z.begin_ns) / 1000.0);
+            ++count;
+        }
+    }
+    fmt::format_to(std::back_inserter(out), "\n]}}\n");
+
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs.is_open()) {
+        ASTRA_LOG_ERROR("Failed to open '{}' for the profile trace", path);
+        return false;
+    }
+    ofs.write(out.data(), static_cast<std::streamsize>(out.size()));
+
+    ASTRA_LOG_INFO("Exported {} profile zones from {} threads to '{}'", count, threads.size(), path);
+    return true;
+}
@@ -1,6 +1,13 @@
 #include "astra/util/rng.hpp"
 
 #include "astra/core/log.hpp"
+#include "astra/util/sampling.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <functional>
 
 void gen_seed_vals() {
     pcg_extras::pcg128_t seed_vals[2];
@@ -25,10 +32,36 @@ astra::rng::seed_data &astra::rng::seed_info() {
     return s;
 }
 
+// Fold the 256 bits of a seed128() call into a Stream key
+std::uint64_t stream_key_from(const pcg_extras::pcg128_t seed, const pcg_extras::pcg128_t stream) {
+    auto key = static_cast<std::uint64_t>(seed >> 64) ^ static_cast<std::uint64_t>(seed);
+    key ^= (static_cast<std::uint64_t>(stream >> 64) ^ static_cast<std::uint64_t>(stream)) * 0x9e3779b97f4a7c15ull;
+    return key;
+}
+
+std::atomic<std::uint64_t> &stream_key_storage() {
+    // taken from the seed of whichever thread gets here first, log_seed() makes sure that's the main thread
+    static std::atomic<std::uint64_t> key = std::invoke([] {
+        astra::rng::generator();
+        return stream_key_from(astra::rng::seed_info().seed, astra::rng::seed_info().stream);
+    });
+    return key;
+}
+
+std::uint64_t astra::rng::stream_key() {
+    return stream_key_storage().load(std::memory_order_relaxed);
+}
+
+void astra::rng::set_stream_key(const std::uint64_t key) {
+    stream_key_storage().store(key, std::memory_order_relaxed);
+}
+
 void astra::rng::reseed() {
     generator(); // Make sure the generator has been invoked before
     gen_seed_vals();
     generator().seed(seed_info().seed, seed_info().stream);
+    bulk_generator().seed(generator());
+    set_stream_key(stream_key_from(seed_info().seed, seed_info().stream));
 }
 
 void astra::rng::seed128(
@@ -41,10 +74,13 @@ void astra::rng::seed128(
     generator().seed(seed, stream);
     seed_info().seed = seed;
     seed_info().stream = stream;
+    bulk_generator().seed(generator());
+    set_stream_key(stream_key_from(seed, stream));
 }
 
 void astra::rng::log_seed() {
     generator(); // Make sure the generator has been invoked before
+    stream_key(); // Pin the stream key to this thread's seed so the logged seed128() call replays it
 
     auto seed_hi = static_cast<std::uint64_t>(seed_info().seed >> 64);
     auto seed_lo = static_cast<std::uint64_t>(seed_info().seed);
@@ -64,9 +100,201 @@ std::string astra::rng::base58(const std::size_t length) {
 }
 
 glm::vec2 astra::rng::area_circle(glm::vec2 center, double radius) {
+    // sqrt keeps the density uniform over the area, a uniform radius would bunch points up in the middle
     const auto theta = get<double>(2 * std::numbers::pi);
-    const auto r = get<double>(0.0, radius);
+    const auto r = radius * std::sqrt(get<double>(0.0, 1.0));
     const double ox = r * std::sin(theta);
     const double oy = r * std::cos(theta);
     return center + glm::vec2(ox, oy);
 }
+
+// The top bits of a xoshiro256++ output are the strongest, the conversions below take from the top
+constexpr std::size_t BULK_CHUNK_SIZE = 256;
+
+float to_unit_float(const std::uint64_t x) {
+    return static_cast<float>(x >> 40) * 0x1.0p-24f;
+}
+
+double to_unit_double(const std::uint64_t x) {
+    return static_cast<double>(x >> 11) * 0x1.0p-53;
+}
+
+// Generate raw values in fixed chunks and hand each chunk to f(raw, offset)
+template<typename F>
+void for_each_bulk_chunk(const std::size_t count, F &&f) {
+    std::array<std::uint64_t, BULK_CHUNK_SIZE> raw{};
+    for (std::size_t offset = 0; offset < count; offset += BULK_CHUNK_SIZE) {
+        const auto n = std::min(BULK_CHUNK_SIZE, count - offset);
+        astra::rng::bulk_generator().fill(std::span(raw.data(), n));
+        f(std::span<const std::uint64_t>(raw.data(), n), offset);
+    }
+}
+
+// Lemire's nearly divisionless bounded integer, range is in [1, 2^32]
+std::uint32_t bounded_uint32(const std::uint64_t x, const std::uint64_t range) {
+    if (range > std::numeric_limits<std::uint32_t>::max()) return static_cast<std::uint32_t>(x >> 32);
+
+    auto m = (x >> 32) * range;
+    if (static_cast<std::uint32_t>(m) < range) {
+        const auto threshold = static_cast<std::uint32_t>(-static_cast<std::uint32_t>(range) % range);
+        while (static_cast<std::uint32_t>(m) < threshold) {
+            std::uint64_t retry;
+            astra::rng::bulk_generator().fill(std::span(&retry, 1));
+            m = (retry >> 32) * range;
+        }
+    }
+    return static_cast<std::uint32_t>(m >> 32);
+}
+
+void astra::rng::BulkGenerator::seed(pcg64 &source) {
+    for (std::size_t i = 0; i < LANES; ++i) {
+        s0_[i] = source();
+        s1_[i] = source();
+        s2_[i] = source();
+        s3_[i] = source();
+        if ((s0_[i] | s1_[i] | s2_[i] | s3_[i]) == 0) s0_[i] = 1; // all zero is the one state xoshiro can't leave
+    }
+}
+
+void astra::rng::BulkGenerator::fill(const std::span<std::uint64_t> out) {
+    auto p = out.data();
+    auto remaining = out.size();
+    for (; remaining >= LANES; remaining -= LANES, p += LANES) step_(p);
+
+    if (remaining > 0) {
+        std::array<std::uint64_t, LANES> tail{};
+        step_(tail.data());
+        std::copy_n(tail.begin(), remaining, p);
+    }
+}
+
+void astra::rng::BulkGenerator::step_(std::uint64_t *out) {
+    for (std::size_t i = 0; i < LANES; ++i) out[i] = std::rotl(s0_[i] + s3_[i], 23) + s0_[i];
+
+    for (std::size_t i = 0; i < LANES; ++i) {
+        const auto t = s1_[i] << 17;
+        s2_[i] ^= s0_[i];
+        s3_[i] ^= s1_[i];
+        s1_[i] ^= s2_[i];
+        s0_[i] ^= s3_[i];
+        s2_[i] ^= t;
+        s3_[i] = std::rotl(s3_[i], 45);
+    }
+}
+
+astra::rng::BulkGenerator &astra::rng::bulk_generator() {
+    thread_local BulkGenerator g = std::invoke([] {
+        BulkGenerator b;
+        b.seed(generator());
+        return b;
+    });
+
+    return g;
+}
+
+void astra::rng::fill(const std::span<float> out, float low, float high) {
+    if (low > high) std::swap(low, high);
+    const auto range = high - low;
+    for_each_bulk_chunk(out.size(), [&](const auto raw, const auto offset) {
+        for (std::size_t i = 0; i < raw.size(); ++i) out[offset + i] = low + to_unit_float(raw[i]) * range;
+    });
+}
+
+void astra::rng::fill(const std::span<double> out, double low, double high) {
+    if (low > high) std::swap(low, high);
+    const auto range = high - low;
+    for_each_bulk_chunk(out.size(), [&](const auto raw, const auto offset) {
+        for (std::size_t i = 0; i < raw.size(); ++i) out[offset + i] = low + to_unit_double(raw[i]) * range;
+    });
+}
+
+void astra::rng::fill(const std::span<std::int32_t> out, std::int32_t low, std::int32_t high) {
+    if (low > high) std::swap(low, high);
+    const auto range = static_cast<std::uint64_t>(static_cast<std::int64_t>(high) - low) + 1;
+    for_each_bulk_chunk(out.size(), [&](const auto raw, const auto offset) {
+        for (std::size_t i = 0; i < raw.size(); ++i) {
+            const auto r = bounded_uint32(raw[i], range);
+            out[offset + i] = static_cast<std::int32_t>(static_cast<std::uint32_t>(low) + r);
+        }
+    });
+}
+
+void astra::rng::fill(const std::span<std::uint32_t> out, std::uint32_t low, std::uint32_t high) {
+    if (low > high) std::swap(low, high);
+    const auto range = static_cast<std::uint64_t>(high - low) + 1;
+    for_each_bulk_chunk(out.size(), [&](const auto raw, const auto offset) {
+        for (std::size_t i = 0; i < raw.size(); ++i) out[offset + i] = low + bounded_uint32(raw[i], range);
+    });
+}
+
+void astra::rng::fill(const std::span<bool> out, const double chance) {
+    for_each_bulk_chunk(out.size(), [&](const auto raw, const auto offset) {
+        for (std::size_t i = 0; i < raw.size(); ++i) out[offset + i] = to_unit_double(raw[i]) < chance;
+    });
+}
+
+void astra::rng::fill_unit_vectors(const std::span<glm::vec2> out) {
+    for_each_bulk_chunk(out.size(), [&](const auto raw, const auto offset) {
+        for (std::size_t i = 0; i < raw.size(); ++i) {
+            const auto theta = to_unit_float(raw[i]) * 2.0f * std::numbers::pi_v<float>;
+            out[offset + i] = {std::cos(theta), std::sin(theta)};
+        }
+    });
+}
+
+void astra::rng::fill_area_circle(const std::span<glm::vec2> out, const glm::vec2 center, const double radius) {
+    fill_disc(out, center, static_cast<float>(radius));
+}
+
+astra::rng::Stream::Stream(const std::uint64_t entity, const std::uint32_t frame)
+    : Stream(stream_key(), entity, frame) {}
+
+astra::rng::Stream::Stream(const std::uint64_t key, const std::uint64_t entity, const std::uint32_t frame)
+    : key_({static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32)}),
+      counter_({0, frame, static_cast<std::uint32_t>(entity), static_cast<std::uint32_t>(entity >> 32)}) {}
+
+astra::rng::Stream::result_type astra::rng::Stream::operator()() {
+    if (next_ == block_.size()) generate_block_();
+    return block_[next_++];
+}
+
+void astra::rng::Stream::discard(std::uint64_t n) {
+    // skip whole blocks by moving the counter, the generator has no state besides it
+    const auto left = block_.size() - next_;
+    if (n <= left) {
+        next_ += n;
+        return;
+    }
+    n -= left;
+    counter_[0] += static_cast<std::uint32_t>((n - 1) / block_.size());
+    generate_block_();
+    next_ = (n - 1) % block_.size() + 1;
+}
+
+float astra::rng::Stream::unit() {
+    return static_cast<float>((*this)() >> 8) * 0x1.0p-24f;
+}
+
+void astra::rng::Stream::generate_block_() {
+    static constexpr std::uint32_t M0 = 0xd2511f53;
+    static constexpr std::uint32_t M1 = 0xcd9e8d57;
+    static constexpr std::uint32_t W0 = 0x9e3779b9;
+    static constexpr std::uint32_t W1 = 0xbb67ae85;
+
+    auto c = counter_;
+    auto k = key_;
+    for (int round = 0; round < 10; ++round) {
+        const auto p0 = static_cast<std::uint64_t>(M0) * c[0];
+        const auto p1 = static_cast<std::uint64_t>(M1) * c[2];
+        c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k[0],
+             static_cast<std::uint32_t>(p1),
+             static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k[1],
+             static_cast<std::uint32_t>(p0)};
+        k[0] += W0;
+        k[1] += W1;
+    }
+
+    block_ = c;
+    next_ = 0;
+    ++counter_[0];
+}
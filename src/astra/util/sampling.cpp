@@ -0,0 +1,237 @@
+#include "astra/util/sampling.hpp"
+
+#include "astra/util/rng.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+constexpr std::size_t SAMPLING_CHUNK_SIZE = 512;
+
+/* Uniform points in the unit disc by rejection from [-1, 1]^2, about 1.27 draws per point
+ *
+ * The squared length of such a point is itself uniform in [0, 1], which is what the ring sampler uses as its radius
+ * draw, so points right at the center are rejected as well to keep p / |p| well defined.
+ */
+void fill_unit_disc(const std::span<glm::vec2> out) {
+    std::array<float, SAMPLING_CHUNK_SIZE> raw{};
+
+    std::size_t n = 0;
+    while (n < out.size()) {
+        // about 4/3 pairs per missing point, so small requests don't pay for a full chunk
+        const auto count = std::min(raw.size(), ((out.size() - n) * 8 / 3 + 8) & ~std::size_t{1});
+        astra::rng::fill(std::span(raw.data(), count), -1.0f, 1.0f);
+        for (std::size_t i = 0; i < count && n < out.size(); i += 2) {
+            const auto d2 = raw[i] * raw[i] + raw[i + 1] * raw[i + 1];
+            out[n] = {raw[i], raw[i + 1]};
+            n += static_cast<std::size_t>(d2 <= 1.0f && d2 > 1e-12f);
+        }
+    }
+}
+
+// Parallelogram trick, folded back into the triangle when it lands in the other half
+glm::vec2 point_in_triangle(const glm::vec2 a, const glm::vec2 ab, const glm::vec2 ac, float u, float v) {
+    const auto outside = u + v > 1.0f;
+    u = outside ? 1.0f - u : u;
+    v = outside ? 1.0f - v : v;
+    return a + ab * u + ac * v;
+}
+
+float cross(const glm::vec2 o, const glm::vec2 a, const glm::vec2 b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Ear clipping, O(n^2) in the vertex count which is fine for level-sized polygons
+std::vector<std::array<glm::vec2, 3>> triangulate(const std::span<const glm::vec2> vertices) {
+    std::vector<std::array<glm::vec2, 3>> triangles;
+    if (vertices.size() < 3) return triangles;
+
+    auto area = 0.0f;
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        const auto &p = vertices[i];
+        const auto &q = vertices[(i + 1) % vertices.size()];
+        area += p.x * q.y - q.x * p.y;
+    }
+    const auto winding = area >= 0.0f ? 1.0f : -1.0f;
+
+    std::vector<std::size_t> remaining(vertices.size());
+    for (std::size_t i = 0; i < remaining.size(); ++i) remaining[i] = i;
+
+    const auto inside = [&](const glm::vec2 p, const glm::vec2 a, const glm::vec2 b, const glm::vec2 c) {
+        return cross(a, b, p) * winding >= 0.0f && cross(b, c, p) * winding >= 0.0f &&
+               cross(c, a, p) * winding >= 0.0f;
+    };
+
+    while (remaining.size() > 3) {
+        bool clipped = false;
+        for (std::size_t i = 0; i < remaining.size(); ++i) {
+            const auto prev = remaining[(i + remaining.size() - 1) % remaining.size()];
+            const auto curr = remaining[i];
+            const auto next = remaining[(i + 1) % remaining.size()];
+            const auto &a = vertices[prev];
+            const auto &b = vertices[curr];
+            const auto &c = vertices[next];
+
+            if (cross(a, b, c) * winding <= 0.0f) continue; // reflex or degenerate
+
+            const auto blocked = std::ranges::any_of(remaining, [&](const std::size_t j) {
+                return j != prev && j != curr && j != next && inside(vertices[j], a, b, c);
+            });
+            if (blocked) continue;
+
+            triangles.push_back({a, b, c});
+            remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(i));
+            clipped = true;
+            break;
+        }
+
+        // self-intersecting input, fan out whatever is left rather than spin forever
+        if (!clipped) {
+            for (std::size_t i = 1; i + 1 < remaining.size(); ++i)
+                triangles.push_back({vertices[remaining[0]], vertices[remaining[i]], vertices[remaining[i + 1]]});
+            return triangles;
+        }
+    }
+
+    triangles.push_back({vertices[remaining[0]], vertices[remaining[1]], vertices[remaining[2]]});
+    return triangles;
+}
+
+void astra::rng::fill_disc(const std::span<glm::vec2> out, const glm::vec2 center, const float radius) {
+    fill_unit_disc(out);
+    for (auto &p: out) p = center + p * radius;
+}
+
+void astra::rng::fill_ring(
+        const std::span<glm::vec2> out, const glm::vec2 center, float inner_radius, float outer_radius) {
+    if (inner_radius > outer_radius) std::swap(inner_radius, outer_radius);
+
+    // |p|^2 of a unit disc point is uniform, so it doubles as the area-uniform radius draw
+    const auto r2_min = inner_radius * inner_radius;
+    const auto r2_range = outer_radius * outer_radius - r2_min;
+
+    fill_unit_disc(out);
+    for (auto &p: out) {
+        const auto d2 = p.x * p.x + p.y * p.y;
+        const auto r = std::sqrt(d2 * r2_range + r2_min);
+        p = center + p * (r / std::sqrt(d2));
+    }
+}
+
+void astra::rng::fill_rect(const std::span<glm::vec2> out, const glm::vec2 min, const glm::vec2 max) {
+    std::array<float, SAMPLING_CHUNK_SIZE> raw{};
+    const auto size = max - min;
+
+    for (std::size_t offset = 0; offset < out.size(); offset += raw.size() / 2) {
+        const auto n = std::min(raw.size() / 2, out.size() - offset);
+        fill(std::span(raw.data(), n * 2), 0.0f, 1.0f);
+        for (std::size_t i = 0; i < n; ++i)
+            out[offset + i] = {min.x + raw[2 * i] * size.x, min.y + raw[2 * i + 1] * size.y};
+    }
+}
+
+void astra::rng::fill_triangle(
+        const std::span<glm::vec2> out, const glm::vec2 a, const glm::vec2 b, const glm::vec2 c) {
+    std::array<float, SAMPLING_CHUNK_SIZE> raw{};
+    const auto ab = b - a;
+    const auto ac = c - a;
+
+    for (std::size_t offset = 0; offset < out.size(); offset += raw.size() / 2) {
+        const auto n = std::min(raw.size() / 2, out.size() - offset);
+        fill(std::span(raw.data(), n * 2), 0.0f, 1.0f);
+        for (std::size_t i = 0; i < n; ++i)
+            out[offset + i] = point_in_triangle(a, ab, ac, raw[2 * i], raw[2 * i + 1]);
+    }
+}
+
+void astra::rng::fill_polygon(const std::span<glm::vec2> out, const std::span<const glm::vec2> vertices) {
+    const auto triangles = triangulate(vertices);
+    if (triangles.empty()) return;
+
+    // pick triangles in proportion to their area
+    std::vector<float> cumulative_area(triangles.size());
+    auto total = 0.0f;
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+        const auto &t = triangles[i];
+        total += std::abs(cross(t[0], t[1], t[2]));
+        cumulative_area[i] = total;
+    }
+
+    std::array<float, SAMPLING_CHUNK_SIZE - SAMPLING_CHUNK_SIZE % 3> raw{};
+    for (std::size_t offset = 0; offset < out.size(); offset += raw.size() / 3) {
+        const auto n = std::min(raw.size() / 3, out.size() - offset);
+        fill(std::span(raw.data(), n * 3), 0.0f, 1.0f);
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto pick = std::ranges::upper_bound(cumulative_area, raw[3 * i] * total);
+            const auto &t = triangles[std::min<std::size_t>(pick - cumulative_area.begin(), triangles.size() - 1)];
+            const auto u = raw[3 * i + 1];
+            const auto v = raw[3 * i + 2];
+            out[offset + i] = point_in_triangle(t[0], t[1] - t[0], t[2] - t[0], u, v);
+        }
+    }
+}
+
+std::vector<glm::vec2> astra::rng::poisson_disc(
+        const glm::vec2 min, const glm::vec2 max, const float min_distance, const int attempts) {
+    std::vector<glm::vec2> points;
+    if (min_distance <= 0.0f || max.x <= min.x || max.y <= min.y) return points;
+
+    // cells are small enough to hold at most one point, so a neighbourhood check is a 5x5 block of cells
+    const auto cell_size = min_distance / std::numbers::sqrt2_v<float>;
+    const auto cols = static_cast<std::int64_t>(std::ceil((max.x - min.x) / cell_size));
+    const auto rows = static_cast<std::int64_t>(std::ceil((max.y - min.y) / cell_size));
+    std::vector<std::int32_t> grid(static_cast<std::size_t>(cols * rows), -1);
+
+    const auto cell_of = [&](const glm::vec2 p) {
+        const auto cx = std::clamp(static_cast<std::int64_t>((p.x - min.x) / cell_size), std::int64_t{0}, cols - 1);
+        const auto cy = std::clamp(static_cast<std::int64_t>((p.y - min.y) / cell_size), std::int64_t{0}, rows - 1);
+        return std::pair{cx, cy};
+    };
+
+    const auto min_distance2 = min_distance * min_distance;
+    const auto fits = [&](const glm::vec2 p) {
+        if (p.x < min.x || p.x > max.x || p.y < min.y || p.y > max.y) return false;
+
+        const auto [cx, cy] = cell_of(p);
+        for (auto y = std::max<std::int64_t>(cy - 2, 0); y <= std::min(cy + 2, rows - 1); ++y) {
+            for (auto x = std::max<std::int64_t>(cx - 2, 0); x <= std::min(cx + 2, cols - 1); ++x) {
+                const auto index = grid[static_cast<std::size_t>(y * cols + x)];
+                if (index < 0) continue;
+                const auto d = points[static_cast<std::size_t>(index)] - p;
+                if (d.x * d.x + d.y * d.y < min_distance2) return false;
+            }
+        }
+        return true;
+    };
+
+    const auto add = [&](const glm::vec2 p) {
+        const auto [cx, cy] = cell_of(p);
+        grid[static_cast<std::size_t>(cy * cols + cx)] = static_cast<std::int32_t>(points.size());
+        points.push_back(p);
+    };
+
+    glm::vec2 first;
+    fill_rect(std::span(&first, 1), min, max);
+    add(first);
+
+    std::vector<std::size_t> active{0};
+    std::vector<glm::vec2> candidates(static_cast<std::size_t>(std::max(attempts, 1)));
+    while (!active.empty()) {
+        const auto slot = get<std::size_t>(active.size() - 1);
+        const auto origin = points[active[slot]];
+
+        // candidates in the annulus between r and 2r around the active point
+        fill_ring(candidates, origin, min_distance, 2.0f * min_distance);
+        const auto found = std::ranges::find_if(candidates, fits);
+        if (found != candidates.end()) {
+            active.push_back(points.size());
+            add(*found);
+        } else {
+            active[slot] = active.back();
+            active.pop_back();
+        }
+    }
+
+    return points;
+}
@@ -1,5 +1,7 @@
 #include "astra/util/time.hpp"
 
+#include <utility>
+
 std::string astra::timestamp() {
     return timestamp("{:%Y-%m-%d_%H-%M-%S}");
 }
@@ -30,6 +32,8 @@ std::int64_t astra::time_s() {
 
 astra::FrameCounter::FrameCounter()
     : averager_(1.0),
+      frame_times_(0.99),
+      last_frame_times_(0.99),
       last_alpha_update_(time_ns()) {}
 
 void astra::FrameCounter::update() {
@@ -38,10 +42,15 @@ void astra::FrameCounter::update() {
     timestamps.push_back(now);
     while (timestamps.size() >= 2 && timestamps.back() - timestamps.front() > 1e9) timestamps.pop_front();
     averager_.update(timestamps.size());
+    if (timestamps.size() >= 2) frame_times_.update(dt());
 
     if (now - last_alpha_update_ >= 1e9) {
         averager_.alpha = 2.0 / (timestamps.size() + 1.0);
         last_alpha_update_ = now;
+
+        // a rolling window, otherwise a hitch stays in the p99 (or gets drowned out) for the whole session
+        std::swap(frame_times_, last_frame_times_);
+        frame_times_.clear();
     }
 }
 
@@ -62,3 +71,12 @@ std::vector<double> astra::FrameCounter::fps_history() const {
         history.push_back(1.0 / (static_cast<double>(timestamps[i + 1] - timestamps[i]) / 1e9));
     return history;
 }
+
+double astra::FrameCounter::frame_time_quantile(const double q) const {
+    return last_frame_times_.count() > 0 ? last_frame_times_.quantile(q) : frame_times_.quantile(q);
+}
+
+void astra::FrameCounter::reset_frame_times() {
+    frame_times_.clear();
+    last_frame_times_.clear();
+}
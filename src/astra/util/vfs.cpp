@@ -0,0 +1,286 @@
+#include "astra/util/vfs.hpp"
+
+#include "astra/core/log.hpp"
+#include "astra/util/constexpr_hash.hpp"
+#include "astra/util/platform.hpp"
+#include "astra/util/time.hpp"
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <mutex>
+#include <ranges>
+
+std::span<const std::byte> astra::VfsFile::bytes() const {
+    return bytes_;
+}
+
+std::string_view astra::VfsFile::view() const {
+    return {reinterpret_cast<const char *>(bytes_.data()), bytes_.size()};
+}
+
+std::string astra::VfsFile::text() const {
+    auto contents = std::string(view());
+#if defined(ASTRA_PLATFORM_WINDOWS)
+    // Match what a text mode stream would have given us
+    std::erase(contents, '\r');
+#endif
+    return contents;
+}
+
+astra::VfsFile::VfsFile(std::shared_ptr<const void> pack, const std::span<const std::byte> view)
+    : storage_(std::move(pack)), bytes_(view) {}
+
+astra::VfsFile::VfsFile(MappedFile file)
+    : storage_(std::move(file)) {
+    bytes_ = std::get<MappedFile>(storage_).bytes();
+}
+
+astra::VfsFile::VfsFile(std::vector<std::byte> data)
+    : storage_(std::move(data)) {
+    bytes_ = std::get<std::vector<std::byte>>(storage_);
+}
+
+// Returns the path relative to the mount point, or nullopt if the path isn't under it
+std::optional<std::string_view> strip_mount_point(const std::string_view path, const std::string_view mount_point) {
+    if (mount_point.empty()) return path;
+    if (!path.starts_with(mount_point)) return std::nullopt;
+    if (path.size() == mount_point.size() || path[mount_point.size()] != '/') return std::nullopt;
+    return path.substr(mount_point.size() + 1);
+}
+
+bool astra::Vfs::mount_dir(const std::filesystem::path &dir, const std::string_view mount_point) {
+    if (!std::filesystem::is_directory(dir)) {
+        ASTRA_LOG_ERROR("Failed to mount '{}': not a directory", dir);
+        return false;
+    }
+
+    auto norm_mount_point = normalize_vfs_path(mount_point);
+    if (!norm_mount_point) {
+        ASTRA_LOG_ERROR("Failed to mount '{}': mount point '{}' is outside the root", dir, mount_point);
+        return false;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        mounts_.emplace_back(DirMount_{std::move(*norm_mount_point), dir});
+    }
+    ASTRA_LOG_DEBUG("Mounted directory '{}' at '{}'", dir, mount_point);
+    return true;
+}
+
+bool astra::Vfs::mount_pack(const std::filesystem::path &path, const std::string_view mount_point) {
+    const auto start = time_us();
+
+    auto norm_mount_point = normalize_vfs_path(mount_point);
+    if (!norm_mount_point) {
+        ASTRA_LOG_ERROR("Failed to mount '{}': mount point '{}' is outside the root", path, mount_point);
+        return false;
+    }
+
+    auto file = map_file(path);
+    if (!file) return false;
+
+    const auto bytes = file->bytes();
+    if (bytes.size() < sizeof(ApakHeader)) {
+        ASTRA_LOG_ERROR("Failed to mount '{}': file too small", path);
+        return false;
+    }
+
+    const auto &header = *reinterpret_cast<const ApakHeader *>(bytes.data());
+    if (header.magic != APAK_MAGIC) {
+        ASTRA_LOG_ERROR("Failed to mount '{}': bad magic", path);
+        return false;
+    }
+    if (header.version != APAK_VERSION) {
+        ASTRA_LOG_ERROR("Failed to mount '{}': unsupported version {}", path, header.version);
+        return false;
+    }
+    if (bytes.size() < sizeof(ApakHeader) + std::uint64_t{header.entry_count} * sizeof(ApakEntry)) {
+        ASTRA_LOG_ERROR("Failed to mount '{}': truncated table of contents", path);
+        return false;
+    }
+    if (header.names_offset > bytes.size() || header.names_size > bytes.size() - header.names_offset) {
+        ASTRA_LOG_ERROR("Failed to mount '{}': name table is out of bounds", path);
+        return false;
+    }
+
+    const auto entries = std::span(
+            reinterpret_cast<const ApakEntry *>(bytes.data() + sizeof(ApakHeader)), header.entry_count);
+    for (const auto &e: entries) {
+        if (e.offset > bytes.size() || e.size > bytes.size() - e.offset ||
+            std::uint64_t{e.name_offset} + e.name_size > header.names_size) {
+            ASTRA_LOG_ERROR("Failed to mount '{}': entry is out of bounds", path);
+            return false;
+        }
+    }
+
+    // find() binary searches by hash
+    if (!std::ranges::is_sorted(entries, {}, &ApakEntry::hash)) {
+        ASTRA_LOG_ERROR("Failed to mount '{}': table of contents isn't sorted", path);
+        return false;
+    }
+
+    const auto names =
+            std::string_view(reinterpret_cast<const char *>(bytes.data() + header.names_offset), header.names_size);
+
+    auto pack = std::make_shared<const PackMount_>(
+            PackMount_{std::move(*norm_mount_point), path, std::move(*file), entries, names});
+    {
+        std::lock_guard lock(mutex_);
+        mounts_.emplace_back(std::move(pack));
+    }
+    ASTRA_LOG_DEBUG(
+            "Mounted pack '{}' at '{}' ({} entries, {}us)", path, mount_point, entries.size(), time_us() - start);
+    return true;
+}
+
+void astra::Vfs::unmount_all() {
+    // packs are unmapped once the last VfsFile viewing them is gone, which may be right here
+    decltype(mounts_) mounts;
+    {
+        std::lock_guard lock(mutex_);
+        mounts.swap(mounts_);
+    }
+}
+
+bool astra::Vfs::exists(const std::filesystem::path &path) const {
+    return !std::holds_alternative<std::monostate>(resolve_(path));
+}
+
+std::optional<astra::VfsFile> astra::Vfs::read(const std::filesystem::path &path) const {
+    const auto resolved = resolve_(path);
+
+    if (const auto hit = std::get_if<PackHit_>(&resolved)) return read_pack_entry_(*hit);
+
+    if (const auto file_path = std::get_if<std::filesystem::path>(&resolved)) {
+        if (auto file = map_file(*file_path)) return VfsFile(std::move(*file));
+        return std::nullopt;
+    }
+
+    ASTRA_LOG_ERROR("Failed to open file: '{}'", path);
+    return std::nullopt;
+}
+
+std::vector<std::filesystem::path> astra::Vfs::disk_candidates(const std::filesystem::path &path) const {
+    std::vector<std::filesystem::path> candidates;
+    if (!path.is_absolute()) {
+        const auto norm = normalize_vfs_path(path);
+        if (!norm) return candidates;
+
+        const auto in_pack = walk_mounts_(
+                *norm,
+                [&](std::filesystem::path full_path) {
+                    candidates.push_back(std::move(full_path));
+                    return false;
+                },
+                [](const PackHit_ &) { return true; });
+        if (in_pack) return candidates;
+    }
+
+    candidates.push_back(path);
+    return candidates;
+}
+
+template<typename OnDir, typename OnPack>
+bool astra::Vfs::walk_mounts_(const std::string_view norm, OnDir &&on_dir, OnPack &&on_pack) const {
+    std::shared_lock lock(mutex_);
+    for (const auto &mount: mounts_ | std::views::reverse) {
+        if (const auto dir = std::get_if<DirMount_>(&mount)) {
+            const auto rel = strip_mount_point(norm, dir->mount_point);
+            if (rel && on_dir(dir->root / *rel)) return true;
+
+        } else {
+            const auto &pack = std::get<std::shared_ptr<const PackMount_>>(mount);
+            const auto rel = strip_mount_point(norm, pack->mount_point);
+            if (!rel) continue;
+
+            if (const auto entry = pack->find(*rel); entry && on_pack(PackHit_{pack, entry})) return true;
+        }
+    }
+    return false;
+}
+
+astra::Vfs::Resolved_ astra::Vfs::resolve_(const std::filesystem::path &path) const {
+    if (!path.is_absolute()) {
+        const auto norm = normalize_vfs_path(path);
+        if (!norm) return std::monostate{}; // not resolved against the working directory either
+
+        Resolved_ resolved;
+        const auto found = walk_mounts_(
+                *norm,
+                [&](std::filesystem::path full_path) {
+                    if (!std::filesystem::is_regular_file(full_path)) return false;
+                    resolved = std::move(full_path);
+                    return true;
+                },
+                [&](PackHit_ hit) {
+                    resolved = std::move(hit);
+                    return true;
+                });
+        if (found) return resolved;
+    }
+
+    if (!std::filesystem::is_regular_file(path)) return std::monostate{};
+    return path;
+}
+
+const astra::ApakEntry *astra::Vfs::PackMount_::find(const std::string_view name) const {
+    const auto hash = fnv1a_64(name);
+
+    const auto [first, last] = std::ranges::equal_range(entries, hash, {}, &ApakEntry::hash);
+    for (auto it = first; it != last; ++it)
+        if (names.substr(it->name_offset, it->name_size) == name) return &*it;
+
+    return nullptr;
+}
+
+std::optional<astra::VfsFile> astra::Vfs::read_pack_entry_(const PackHit_ &hit) {
+    const auto &pack = *hit.pack;
+    const auto &entry = *hit.entry;
+    const auto data = pack.file.bytes().subspan(entry.offset, entry.size);
+
+    switch (entry.compression) {
+    case ApakCompression::None: return VfsFile(hit.pack, data);
+
+    case ApakCompression::Lz4: {
+        std::vector<std::byte> out(entry.uncompressed_size);
+        const auto n = LZ4_decompress_safe(
+                reinterpret_cast<const char *>(data.data()),
+                reinterpret_cast<char *>(out.data()),
+                static_cast<int>(data.size()),
+                static_cast<int>(out.size()));
+        if (n < 0 || static_cast<std::uint64_t>(n) != entry.uncompressed_size) {
+            ASTRA_LOG_ERROR(
+                    "Failed to decompress '{}' from pack '{}'",
+                    pack.names.substr(entry.name_offset, entry.name_size),
+                    pack.path);
+            return std::nullopt;
+        }
+        return VfsFile(std::move(out));
+    }
+
+    default:
+        ASTRA_LOG_ERROR(
+                "Unknown compression for '{}' in pack '{}'",
+                pack.names.substr(entry.name_offset, entry.name_size),
+                pack.path);
+        return std::nullopt;
+    }
+}
+
+astra::Vfs &astra::vfs() {
+    static Vfs v;
+    return v;
+}
+
+std::optional<std::string> astra::normalize_vfs_path(const std::filesystem::path &path) {
+    auto s = path.lexically_normal().generic_string();
+    while (s.starts_with("./")) s.erase(0, 2);
+    while (s.ends_with('/')) s.pop_back();
+    if (s == ".") s.clear();
+
+    // lexically_normal folds every ".." that has a parent to cancel, a leading one is left over
+    if (s == ".." || s.starts_with("../")) return std::nullopt;
+    return s;
+}
@@ -0,0 +1,24 @@
+#include "gloo/counters.hpp"
+
+gloo::Counters &last_counters() {
+    static gloo::Counters c;
+    return c;
+}
+
+gloo::Counters &gloo::detail::current_counters() {
+    static Counters c;
+    return c;
+}
+
+const gloo::Counters &gloo::frame_counters() {
+    return detail::current_counters();
+}
+
+const gloo::Counters &gloo::last_frame_counters() {
+    return last_counters();
+}
+
+void gloo::end_frame_counters() {
+    last_counters() = detail::current_counters();
+    detail::current_counters() = {};
+}
@@ -0,0 +1,102 @@
+#include "gloo/gpu_timer.hpp"
+
+#include "astra/core/log.hpp"
+
+gloo::GpuTimer::GpuTimer(const std::size_t max_scopes)
+    : max_scopes_(max_scopes),
+      frames_(FRAMES_IN_FLIGHT) {
+    for (auto &frame: frames_) {
+        frame.queries.resize(2 * max_scopes_);
+        glCreateQueries(GL_TIMESTAMP, static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+        frame.scopes.reserve(max_scopes_);
+    }
+    results_.reserve(max_scopes_);
+    ASTRA_LOG_TRACE("Created GPU timer ({} frames x {} scopes)", FRAMES_IN_FLIGHT, max_scopes_);
+}
+
+gloo::GpuTimer::~GpuTimer() {
+    for (auto &frame: frames_)
+        glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+    ASTRA_LOG_TRACE("Deleted GPU timer");
+}
+
+void gloo::GpuTimer::new_frame() {
+    if (!open_.empty()) {
+        ASTRA_LOG_WARN("GPU timer frame ended with {} scopes still open", open_.size());
+        while (!open_.empty()) end();
+    }
+
+    current_ = (current_ + 1) % frames_.size();
+    auto &frame = frames_[current_];
+    if (!frame.scopes.empty() && !read_back_(frame)) ++dropped_frames_;
+    frame.scopes.clear();
+}
+
+void gloo::GpuTimer::begin(const char *name) {
+    auto &frame = frames_[current_];
+    if (frame.scopes.size() == max_scopes_) {
+        if (!warned_overflow_)
+            ASTRA_LOG_WARN("GPU timer is out of scopes (max={}), extra ones are ignored", max_scopes_);
+        warned_overflow_ = true;
+        open_.push_back(max_scopes_); // still has to pair with its end()
+        return;
+    }
+
+    const auto index = frame.scopes.size();
+    frame.scopes.push_back({name, static_cast<std::uint32_t>(open_.size())});
+    open_.push_back(index);
+    frame.last = frame.queries[2 * index];
+    glQueryCounter(frame.last, GL_TIMESTAMP);
+}
+
+void gloo::GpuTimer::end() {
+    if (open_.empty()) {
+        ASTRA_LOG_ERROR("GPU timer end() without a matching begin()");
+        return;
+    }
+
+    const auto index = open_.back();
+    open_.pop_back();
+    if (index == max_scopes_) return;
+
+    auto &frame = frames_[current_];
+    frame.last = frame.queries[2 * index + 1];
+    glQueryCounter(frame.last, GL_TIMESTAMP);
+}
+
+std::span<const gloo::GpuTimer::Result> gloo::GpuTimer::results() const {
+    return results_;
+}
+
+std::uint64_t gloo::GpuTimer::dropped_frames() const {
+    return dropped_frames_;
+}
+
+bool gloo::GpuTimer::read_back_(const Frame_ &frame) {
+    // queries finish in submission order, if the last one is done they all are
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(frame.last, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE) return false;
+
+    results_.clear();
+    for (std::size_t i = 0; i < frame.scopes.size(); ++i) {
+        GLuint64 begin_ns = 0;
+        GLuint64 end_ns = 0;
+        glGetQueryObjectui64v(frame.queries[2 * i], GL_QUERY_RESULT, &begin_ns);
+        glGetQueryObjectui64v(frame.queries[2 * i + 1], GL_QUERY_RESULT, &end_ns);
+        results_.push_back(
+                {frame.scopes[i].name,
+                 frame.scopes[i].depth,
+                 static_cast<double>(end_ns - begin_ns) / 1e6});
+    }
+    return true;
+}
+
+gloo::GpuTimer::Scope::Scope(GpuTimer *timer, const char *name)
+    : timer_(timer) {
+    if (timer_) timer_->begin(name);
+}
+
+gloo::GpuTimer::Scope::~Scope() {
+    if (timer_) timer_->end();
+}
@@ -2,6 +2,8 @@
 
 #include "astra/core/log.hpp"
 #include "astra/util/io.hpp"
+#include "gloo/counters.hpp"
+#include "gloo/state.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -10,6 +12,7 @@ gloo::Shader::Shader(const GLuint id)
 
 gloo::Shader::~Shader() {
     if (id != 0) {
+        state::forget_program(id);
         glDeleteProgram(id);
         ASTRA_LOG_TRACE("Deleted shader program (id={})", id);
     }
@@ -37,7 +40,7 @@ gloo::Shader &gloo::Shader::operator=(Shader &&other) noexcept {
 }
 
 void gloo::Shader::use() const {
-    glUseProgram(id);
+    state::use_program(id);
 }
 
 std::optional<GLuint> gloo::Shader::try_get_attrib_location(const std::string &name) {
@@ -56,49 +59,58 @@ std::optional<GLuint> gloo::Shader::try_get_attrib_location(const std::string &n
     return it->second;
 }
 
+// Looks the location up, counts and uploads, a uniform that doesn't exist is neither
+template<typename F, typename... Args>
+void gloo::Shader::upload_(const std::string &name, F &&f, Args &&...args) {
+    if (const auto loc = try_get_uniform_location_(name)) {
+        GLOO_COUNT(uniform_uploads, 1);
+        f(*loc, std::forward<Args>(args)...);
+    }
+}
+
 void gloo::Shader::uniform_1f(const std::string &name, const float v0) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform1f(*loc, v0);
+    upload_(name, glUniform1f, v0);
 }
 
 void gloo::Shader::uniform_2f(const std::string &name, const float v0, const float v1) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform2f(*loc, v0, v1);
+    upload_(name, glUniform2f, v0, v1);
 }
 
 void gloo::Shader::uniform_3f(const std::string &name, const float v0, const float v1, const float v2) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform3f(*loc, v0, v1, v2);
+    upload_(name, glUniform3f, v0, v1, v2);
 }
 
 void gloo::Shader::uniform_4f(const std::string &name, const float v0, const float v1, const float v2, const float v3) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform4f(*loc, v0, v1, v2, v3);
+    upload_(name, glUniform4f, v0, v1, v2, v3);
 }
 
 void gloo::Shader::uniform_1i(const std::string &name, const int v0) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform1i(*loc, v0);
+    upload_(name, glUniform1i, v0);
 }
 
 void gloo::Shader::uniform_2i(const std::string &name, const int v0, const int v1) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform2i(*loc, v0, v1);
+    upload_(name, glUniform2i, v0, v1);
 }
 
 void gloo::Shader::uniform_3i(const std::string &name, const int v0, const int v1, const int v2) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform3i(*loc, v0, v1, v2);
+    upload_(name, glUniform3i, v0, v1, v2);
 }
 
 void gloo::Shader::uniform_4i(const std::string &name, const int v0, const int v1, const int v2, const int v3) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform4i(*loc, v0, v1, v2, v3);
+    upload_(name, glUniform4i, v0, v1, v2, v3);
 }
 
 void gloo::Shader::uniform_1u(const std::string &name, const unsigned int v0) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform1ui(*loc, v0);
+    upload_(name, glUniform1ui, v0);
 }
 
 void gloo::Shader::uniform_2u(const std::string &name, const unsigned int v0, const unsigned int v1) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform2ui(*loc, v0, v1);
+    upload_(name, glUniform2ui, v0, v1);
 }
 
 void gloo::Shader::uniform_3u(
         const std::string &name, const unsigned int v0, const unsigned int v1, const unsigned int v2) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform3ui(*loc, v0, v1, v2);
+    upload_(name, glUniform3ui, v0, v1, v2);
 }
 
 void gloo::Shader::uniform_4u(
@@ -107,91 +119,91 @@ void gloo::Shader::uniform_4u(
         const unsigned int v1,
         const unsigned int v2,
         const unsigned int v3) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform4ui(*loc, v0, v1, v2, v3);
+    upload_(name, glUniform4ui, v0, v1, v2, v3);
 }
 
 void gloo::Shader::uniform_1f(const std::string &name, const glm::vec1 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform1fv(*loc, 1, &v.x);
+    upload_(name, glUniform1fv, 1, &v.x);
 }
 
 void gloo::Shader::uniform_2f(const std::string &name, const glm::vec2 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform2fv(*loc, 1, glm::value_ptr(v));
+    upload_(name, glUniform2fv, 1, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_3f(const std::string &name, const glm::vec3 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform3fv(*loc, 1, glm::value_ptr(v));
+    upload_(name, glUniform3fv, 1, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_4f(const std::string &name, const glm::vec4 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform4fv(*loc, 1, glm::value_ptr(v));
+    upload_(name, glUniform4fv, 1, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_1i(const std::string &name, const glm::ivec1 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform1iv(*loc, 1, &v.x);
+    upload_(name, glUniform1iv, 1, &v.x);
 }
 
 void gloo::Shader::uniform_2i(const std::string &name, const glm::ivec2 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform2iv(*loc, 1, glm::value_ptr(v));
+    upload_(name, glUniform2iv, 1, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_3i(const std::string &name, const glm::ivec3 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform3iv(*loc, 1, glm::value_ptr(v));
+    upload_(name, glUniform3iv, 1, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_4i(const std::string &name, const glm::ivec4 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform4iv(*loc, 1, glm::value_ptr(v));
+    upload_(name, glUniform4iv, 1, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_1u(const std::string &name, const glm::uvec1 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform1uiv(*loc, 1, &v.x);
+    upload_(name, glUniform1uiv, 1, &v.x);
 }
 
 void gloo::Shader::uniform_2u(const std::string &name, const glm::uvec2 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform2uiv(*loc, 1, glm::value_ptr(v));
+    upload_(name, glUniform2uiv, 1, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_3u(const std::string &name, const glm::uvec3 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform3uiv(*loc, 1, glm::value_ptr(v));
+    upload_(name, glUniform3uiv, 1, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_4u(const std::string &name, const glm::uvec4 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniform4uiv(*loc, 1, glm::value_ptr(v));
+    upload_(name, glUniform4uiv, 1, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_mat2(const std::string &name, const glm::mat2 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniformMatrix2fv(*loc, 1, GL_FALSE, glm::value_ptr(v));
+    upload_(name, glUniformMatrix2fv, 1, GL_FALSE, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_mat3(const std::string &name, const glm::mat3 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniformMatrix3fv(*loc, 1, GL_FALSE, glm::value_ptr(v));
+    upload_(name, glUniformMatrix3fv, 1, GL_FALSE, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_mat4(const std::string &name, const glm::mat4 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniformMatrix4fv(*loc, 1, GL_FALSE, glm::value_ptr(v));
+    upload_(name, glUniformMatrix4fv, 1, GL_FALSE, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_mat2x3(const std::string &name, const glm::mat2x3 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniformMatrix2x3fv(*loc, 1, GL_FALSE, glm::value_ptr(v));
+    upload_(name, glUniformMatrix2x3fv, 1, GL_FALSE, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_mat3x2(const std::string &name, const glm::mat3x2 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniformMatrix3x2fv(*loc, 1, GL_FALSE, glm::value_ptr(v));
+    upload_(name, glUniformMatrix3x2fv, 1, GL_FALSE, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_mat2x4(const std::string &name, const glm::mat2x4 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniformMatrix2x4fv(*loc, 1, GL_FALSE, glm::value_ptr(v));
+    upload_(name, glUniformMatrix2x4fv, 1, GL_FALSE, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_mat4x2(const std::string &name, const glm::mat4x2 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniformMatrix4x2fv(*loc, 1, GL_FALSE, glm::value_ptr(v));
+    upload_(name, glUniformMatrix4x2fv, 1, GL_FALSE, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_mat3x4(const std::string &name, const glm::mat3x4 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniformMatrix3x4fv(*loc, 1, GL_FALSE, glm::value_ptr(v));
+    upload_(name, glUniformMatrix3x4fv, 1, GL_FALSE, glm::value_ptr(v));
 }
 
 void gloo::Shader::uniform_mat4x3(const std::string &name, const glm::mat4x3 &v) {
-    if (const auto loc = try_get_uniform_location_(name)) glUniformMatrix4x3fv(*loc, 1, GL_FALSE, glm::value_ptr(v));
+    upload_(name, glUniformMatrix4x3fv, 1, GL_FALSE, glm::value_ptr(v));
 }
 
 std::optional<GLint> gloo::Shader::try_get_uniform_location_(const std::string &name) {
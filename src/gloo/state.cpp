@@ -0,0 +1,132 @@
+#include "gloo/state.hpp"
+
+#include "gloo/counters.hpp"
+
+#include <array>
+#include <optional>
+
+// GL guarantees at least this many of each, bindings past them aren't cached and always go to the driver
+constexpr std::size_t VERTEX_BINDINGS = 16;
+constexpr std::size_t TEXTURE_UNITS = 32;
+
+struct CachedVertexBinding {
+    GLuint buffer;
+    GLintptr offset;
+    GLsizei stride;
+
+    bool operator==(const CachedVertexBinding &other) const = default;
+};
+
+struct StateCache {
+    std::optional<GLuint> program;
+    std::optional<GLuint> vertex_array;
+    std::array<std::optional<CachedVertexBinding>, VERTEX_BINDINGS> vertex_bindings;
+    std::array<std::optional<GLuint>, TEXTURE_UNITS> textures;
+
+    std::optional<bool> blend;
+    std::optional<bool> depth_test;
+    std::optional<bool> cull_face;
+    std::optional<bool> scissor_test;
+    std::optional<std::pair<GLenum, GLenum>> blend_func;
+    std::optional<GLenum> depth_func;
+    std::optional<glm::ivec4> viewport;
+};
+
+StateCache &cache() {
+    static StateCache c;
+    return c;
+}
+
+std::optional<bool> *cap_slot(const GLenum cap) {
+    auto &c = cache();
+    switch (cap) {
+    case GL_BLEND: return &c.blend;
+    case GL_DEPTH_TEST: return &c.depth_test;
+    case GL_CULL_FACE: return &c.cull_face;
+    case GL_SCISSOR_TEST: return &c.scissor_test;
+    default: return nullptr;
+    }
+}
+
+// True if the call has to be made, and remembers the new value
+template<typename T>
+bool update(std::optional<T> &slot, const T &value) {
+    if (slot && *slot == value) {
+        GLOO_COUNT(elided_calls, 1);
+        return false;
+    }
+    slot = value;
+    GLOO_COUNT(state_changes, 1);
+    return true;
+}
+
+void gloo::state::use_program(const GLuint id) {
+    if (update(cache().program, id)) glUseProgram(id);
+}
+
+void gloo::state::bind_vertex_array(const GLuint id) {
+    auto &c = cache();
+    if (!update(c.vertex_array, id)) return;
+
+    glBindVertexArray(id);
+    c.vertex_bindings.fill(std::nullopt);
+}
+
+void gloo::state::bind_vertex_buffer(
+        const GLuint binding_index, const GLuint buffer, const GLintptr offset, const GLsizei stride) {
+    auto &c = cache();
+    if (binding_index < VERTEX_BINDINGS && !update(c.vertex_bindings[binding_index], {buffer, offset, stride})) return;
+    glBindVertexBuffer(binding_index, buffer, offset, stride);
+}
+
+void gloo::state::bind_texture_unit(const GLuint unit, const GLuint id) {
+    auto &c = cache();
+    if (unit < TEXTURE_UNITS && !update(c.textures[unit], id)) return;
+    glBindTextureUnit(unit, id);
+}
+
+void gloo::state::set_enabled(const GLenum cap, const bool enabled) {
+    if (const auto slot = cap_slot(cap); slot && !update(*slot, enabled)) return;
+
+    if (enabled) glEnable(cap);
+    else glDisable(cap);
+}
+
+void gloo::state::blend_func(const GLenum src, const GLenum dst) {
+    if (update(cache().blend_func, {src, dst})) glBlendFunc(src, dst);
+}
+
+void gloo::state::depth_func(const GLenum func) {
+    if (update(cache().depth_func, func)) glDepthFunc(func);
+}
+
+void gloo::state::viewport(const glm::ivec4 rect) {
+    if (update(cache().viewport, rect)) glViewport(rect.x, rect.y, rect.z, rect.w);
+}
+
+void gloo::state::forget_program(const GLuint id) {
+    auto &c = cache();
+    if (c.program == id) c.program.reset();
+}
+
+void gloo::state::forget_vertex_array(const GLuint id) {
+    auto &c = cache();
+    if (c.vertex_array != id) return;
+
+    c.vertex_array.reset();
+    c.vertex_bindings.fill(std::nullopt);
+}
+
+void gloo::state::forget_buffer(const GLuint id) {
+    for (auto &b: cache().vertex_bindings)
+        if (b && b->buffer == id) b.reset();
+}
+
+void gloo::state::forget_texture(const GLuint id) {
+    for (auto &t: cache().textures)
+        if (t == id) t.reset();
+}
+
+void gloo::state::invalidate() {
+    cache() = {};
+}
@@ -0,0 +1,132 @@
+#include "gloo/texture.hpp"
+
+#include "astra/core/log.hpp"
+#include "gloo/state.hpp"
+
+gloo::Texture::Texture(
+        const GLuint id, const GLenum target, const GLenum internal_format, const glm::ivec2 size, const GLsizei levels)
+    : id(id),
+      target_(target),
+      internal_format_(internal_format),
+      size_(size),
+      levels_(levels) {}
+
+gloo::Texture::~Texture() {
+    if (id != 0) {
+        state::forget_texture(id);
+        glDeleteTextures(1, &id);
+        ASTRA_LOG_TRACE("Deleted texture (id={})", id);
+    }
+}
+
+gloo::Texture::Texture(Texture &&other) noexcept
+    : id(other.id),
+      target_(other.target_),
+      internal_format_(other.internal_format_),
+      size_(other.size_),
+      levels_(other.levels_) {
+    other.id = 0;
+}
+
+gloo::Texture &gloo::Texture::operator=(Texture &&other) noexcept {
+    if (this != &other) {
+        id = other.id;
+        target_ = other.target_;
+        internal_format_ = other.internal_format_;
+        size_ = other.size_;
+        levels_ = other.levels_;
+        other.id = 0;
+    }
+    return *this;
+}
+
+GLenum gloo::Texture::target() const {
+    return target_;
+}
+
+GLenum gloo::Texture::internal_format() const {
+    return internal_format_;
+}
+
+glm::ivec2 gloo::Texture::size() const {
+    return size_;
+}
+
+GLsizei gloo::Texture::levels() const {
+    return levels_;
+}
+
+void gloo::Texture::upload(
+        const GLint level, const glm::ivec2 size, const GLenum format, const GLenum type, const void *pixels) {
+    switch (target_) {
+    case GL_TEXTURE_1D: glTextureSubImage1D(id, level, 0, size.x, format, type, pixels); break;
+    case GL_TEXTURE_2D: glTextureSubImage2D(id, level, 0, 0, size.x, size.y, format, type, pixels); break;
+    default: ASTRA_LOG_ERROR("Unsupported texture target for upload (id={}, target={:#x})", id, target_);
+    }
+}
+
+void gloo::Texture::upload_compressed(
+        const GLint level, const glm::ivec2 size, const GLsizei byte_size, const void *data) {
+    switch (target_) {
+    case GL_TEXTURE_1D:
+        glCompressedTextureSubImage1D(id, level, 0, size.x, internal_format_, byte_size, data);
+        break;
+    case GL_TEXTURE_2D:
+        glCompressedTextureSubImage2D(id, level, 0, 0, size.x, size.y, internal_format_, byte_size, data);
+        break;
+    default: ASTRA_LOG_ERROR("Unsupported texture target for compressed upload (id={}, target={:#x})", id, target_);
+    }
+}
+
+void gloo::Texture::bind(const GLuint unit) const {
+    state::bind_texture_unit(unit, id);
+}
+
+void gloo::Texture::unbind(const GLuint unit) const {
+    state::bind_texture_unit(unit, 0);
+}
+
+gloo::TextureBuilder::TextureBuilder(const GLenum target)
+    : target_(target) {
+    glCreateTextures(target_, 1, &id_);
+    ASTRA_LOG_TRACE("Created texture (id={})", id_);
+}
+
+gloo::TextureBuilder::~TextureBuilder() {
+    if (id_ != 0) {
+        glDeleteTextures(1, &id_);
+        ASTRA_LOG_TRACE("Deleted unfinished texture (id={})", id_);
+    }
+}
+
+gloo::TextureBuilder &
+gloo::TextureBuilder::storage(const GLenum internal_format, const glm::ivec2 size, const GLsizei levels) {
+    internal_format_ = internal_format;
+    size_ = size;
+    levels_ = levels;
+    return *this;
+}
+
+gloo::TextureBuilder &gloo::TextureBuilder::filter(const GLenum min_filter, const GLenum mag_filter) {
+    glTextureParameteri(id_, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(min_filter));
+    glTextureParameteri(id_, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(mag_filter));
+    return *this;
+}
+
+gloo::TextureBuilder &gloo::TextureBuilder::wrap(const GLenum wrap_s, const GLenum wrap_t) {
+    glTextureParameteri(id_, GL_TEXTURE_WRAP_S, static_cast<GLint>(wrap_s));
+    glTextureParameteri(id_, GL_TEXTURE_WRAP_T, static_cast<GLint>(wrap_t));
+    return *this;
+}
+
+std::unique_ptr<gloo::Texture> gloo::TextureBuilder::build() {
+    switch (target_) {
+    case GL_TEXTURE_1D: glTextureStorage1D(id_, levels_, internal_format_, size_.x); break;
+    case GL_TEXTURE_2D: glTextureStorage2D(id_, levels_, internal_format_, size_.x, size_.y); break;
+    default: ASTRA_LOG_ERROR("Unsupported texture target (id={}, target={:#x})", id_, target_); return nullptr;
+    }
+
+    auto texture = std::unique_ptr<Texture>(new Texture(id_, target_, internal_format_, size_, levels_));
+    id_ = 0; // don't delete the texture when we go out of scope
+    return texture;
+}
@@ -1,12 +1,14 @@
 #include "gloo/vertex_array.hpp"
 
 #include "astra/core/log.hpp"
+#include "gloo/state.hpp"
 
 gloo::VertexArray::VertexArray(const GLuint id)
     : id(id) {}
 
 gloo::VertexArray::~VertexArray() {
     if (id != 0) {
+        state::forget_vertex_array(id);
         glDeleteVertexArrays(1, &id);
         ASTRA_LOG_TRACE("Deleted vertex array (id={})", id);
     }
@@ -26,11 +28,11 @@ gloo::VertexArray &gloo::VertexArray::operator=(VertexArray &&other) noexcept {
 }
 
 void gloo::VertexArray::bind() const {
-    glBindVertexArray(id);
+    state::bind_vertex_array(id);
 }
 
 void gloo::VertexArray::unbind() const {
-    glBindVertexArray(0);
+    state::bind_vertex_array(0);
 }
 
 gloo::VertexArrayBuilder::VertexArrayBuilder() {
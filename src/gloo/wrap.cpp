@@ -1,7 +1,29 @@
 #include "gloo/wrap.hpp"
 
+#include "gloo/counters.hpp"
+
 void gloo::clear(const astra::Color &color, GLenum clear_bits) {
     const auto gl_color = color.gl_color();
+    GLOO_COUNT(clears, 1);
     glClearColor(gl_color.r, gl_color.g, gl_color.b, gl_color.a);
     glClear(clear_bits);
 }
+
+void gloo::draw_arrays(const GLenum mode, const GLint first, const GLsizei count) {
+    GLOO_COUNT(draw_calls, 1);
+    GLOO_COUNT(vertices, count);
+    glDrawArrays(mode, first, count);
+}
+
+void gloo::draw_arrays_instanced(
+        const GLenum mode, const GLint first, const GLsizei count, const GLsizei instance_count) {
+    GLOO_COUNT(draw_calls, 1);
+    GLOO_COUNT(vertices, static_cast<std::uint64_t>(count) * static_cast<std::uint64_t>(instance_count));
+    glDrawArraysInstanced(mode, first, count, instance_count);
+}
+
+void gloo::draw_elements(const GLenum mode, const GLsizei count, const GLenum type, const void *indices) {
+    GLOO_COUNT(draw_calls, 1);
+    GLOO_COUNT(vertices, count);
+    glDrawElements(mode, count, type, indices);
+}
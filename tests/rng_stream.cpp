@@ -0,0 +1,78 @@
+#include "astra/util/rng.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/* rng::Stream output has to be a pure function of (key, entity, frame, draw index)
+ *
+ * Draws the same entities once on this thread and once spread over N threads that walk them in reverse, and fails
+ * unless every value is bit-identical. Also checks the Random123 known-answer vector and that discard() lands where
+ * drawing would.
+ */
+
+constexpr std::uint64_t KEY = 0x243f6a8885a308d3;
+constexpr std::uint64_t ENTITIES = 1000;
+constexpr std::uint32_t FRAMES = 4;
+constexpr std::size_t DRAWS = 37; // not a multiple of 4, so the last block is left half used
+
+void draw(const std::uint64_t entity, std::vector<std::uint32_t> &out) {
+    for (std::uint32_t frame = 0; frame < FRAMES; ++frame) {
+        auto stream = astra::rng::Stream(entity, frame);
+        const auto at = out.begin() + static_cast<std::ptrdiff_t>((entity * FRAMES + frame) * DRAWS);
+        std::generate_n(at, DRAWS, stream);
+    }
+}
+
+int main() {
+    auto failed = 0;
+
+    // Random123 philox4x32_10 with key {0, 0} and counter {0, 0, 0, 0}
+    constexpr std::array<std::uint32_t, 4> known{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+    auto zero = astra::rng::Stream(0, 0, 0);
+    for (const auto expected: known) {
+        if (const auto value = zero(); value != expected) {
+            fmt::println(stderr, "known answer: got {:08x}, expected {:08x}", value, expected);
+            ++failed;
+        }
+    }
+
+    astra::rng::set_stream_key(KEY);
+
+    std::vector<std::uint32_t> single(ENTITIES * FRAMES * DRAWS);
+    for (std::uint64_t e = 0; e < ENTITIES; ++e) draw(e, single);
+
+    const auto thread_count = std::max(4u, std::thread::hardware_concurrency());
+    std::vector<std::uint32_t> threaded(single.size());
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t] {
+                for (auto e = ENTITIES - 1 - t; e < ENTITIES; e -= thread_count) draw(e, threaded);
+            });
+        }
+    }
+
+    if (const auto [a, b] = std::ranges::mismatch(single, threaded); a != single.end()) {
+        fmt::println(stderr, "1 vs {} threads: first difference at draw {}", thread_count, a - single.begin());
+        ++failed;
+    }
+
+    for (const auto n: {1u, 3u, 4u, 5u, 1000u}) {
+        auto drawn = astra::rng::Stream(42, 7);
+        for (unsigned i = 0; i < n; ++i) drawn();
+        auto skipped = astra::rng::Stream(42, 7);
+        skipped.discard(n);
+        if (drawn() != skipped()) {
+            fmt::println(stderr, "discard({}) doesn't match drawing {} values", n, n);
+            ++failed;
+        }
+    }
+
+    if (failed == 0) fmt::println("rng::Stream: {} values identical on 1 and {} threads", single.size(), thread_count);
+    return failed == 0 ? 0 : 1;
+}
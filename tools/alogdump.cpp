@@ -0,0 +1,174 @@
+#include "astra/core/binlog.hpp"
+
+#include <fmt/args.h>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <fmt/std.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* alogdump <input.alog> [--source]
+ *
+ * Prints a binary log written through ASTRA_BLOG_* as text, in the same "[%H:%M:%S] [%L] %v" shape as the text log.
+ * Lines are sorted by time, records from different threads are only in order within each thread in the file. A file
+ * cut short by a crash is printed up to the last complete record.
+ */
+
+struct SiteInfo {
+    astra::AlogSite site;
+    std::vector<astra::AlogArg> types;
+    std::string file;
+    std::string format;
+};
+
+std::optional<std::vector<char>> read_file(const std::filesystem::path &path) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open()) return std::nullopt;
+    return std::vector<char>(std::istreambuf_iterator(ifs), std::istreambuf_iterator<char>());
+}
+
+template<typename T>
+T read(const char *p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+// Falls back to the raw format string and arguments when the format doesn't match them
+std::string render(const SiteInfo &info, const char *p, const char *end) {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    std::vector<std::string> raw;
+
+    for (const auto type: info.types) {
+        if (type == astra::AlogArg::String) {
+            if (end - p < 4) return "<truncated arguments>";
+            const auto size = read<std::uint32_t>(p);
+            if (static_cast<std::size_t>(end - p - 4) < size) return "<truncated arguments>";
+            auto s = std::string(p + 4, size);
+            raw.push_back(s);
+            store.push_back(std::move(s));
+            p += 4 + size;
+            continue;
+        }
+
+        if (end - p < 8) return "<truncated arguments>";
+        const auto bits = read<std::uint64_t>(p);
+        p += 8;
+        switch (type) {
+        case astra::AlogArg::Bool: store.push_back(bits != 0); break;
+        case astra::AlogArg::Char: store.push_back(static_cast<char>(bits)); break;
+        case astra::AlogArg::Int: store.push_back(static_cast<std::int64_t>(bits)); break;
+        case astra::AlogArg::Uint: store.push_back(bits); break;
+        case astra::AlogArg::Float: store.push_back(std::bit_cast<double>(bits)); break;
+        case astra::AlogArg::Pointer:
+            store.push_back(reinterpret_cast<const void *>(static_cast<std::uintptr_t>(bits)));
+            break;
+        default: return fmt::format("<unknown argument type {}>", static_cast<int>(type));
+        }
+        raw.push_back(fmt::format("{:#x}", bits));
+    }
+
+    try {
+        return fmt::vformat(info.format, store);
+    } catch (const fmt::format_error &e) {
+        return fmt::format("{} <{}: {}>", info.format, e.what(), fmt::join(raw, ", "));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        fmt::println(stderr, "usage: alogdump <input.alog> [--source]");
+        return 1;
+    }
+
+    const std::filesystem::path input = argv[1];
+    const bool source = argc > 2 && std::string_view(argv[2]) == "--source";
+
+    const auto data = read_file(input);
+    if (!data) {
+        fmt::println(stderr, "Failed to read '{}'", input);
+        return 1;
+    }
+
+    const auto begin = data->data();
+    const auto end = begin + data->size();
+    if (data->size() < sizeof(astra::AlogHeader)) {
+        fmt::println(stderr, "'{}' is too small to be an ALOG file", input);
+        return 1;
+    }
+
+    const auto header = read<astra::AlogHeader>(begin);
+    if (header.magic != astra::ALOG_MAGIC) {
+        fmt::println(stderr, "'{}' is not an ALOG file", input);
+        return 1;
+    }
+    if (header.version != astra::ALOG_VERSION) {
+        fmt::println(stderr, "'{}' has unsupported version {}", input, header.version);
+        return 1;
+    }
+
+    std::unordered_map<std::uint32_t, SiteInfo> sites;
+    std::vector<std::pair<std::uint64_t, std::string>> lines; // each thread writes its own chunks, sorted by time below
+
+    auto p = begin + sizeof(astra::AlogHeader);
+    while (p < end) {
+        if (static_cast<std::size_t>(end - p) < sizeof(astra::AlogRecord)) break;
+        const auto record = read<astra::AlogRecord>(p);
+        const auto body = p + sizeof(astra::AlogRecord);
+        if (static_cast<std::size_t>(end - body) < record.size) break;
+        p = body + record.size;
+
+        if (record.site == astra::ALOG_SITE_DEFINITION) {
+            if (record.size < sizeof(astra::AlogSite)) continue;
+            SiteInfo info{read<astra::AlogSite>(body), {}, {}, {}};
+            auto q = body + sizeof(astra::AlogSite);
+            if (sizeof(astra::AlogSite) + info.site.arg_count + info.site.file_size + info.site.format_size >
+                record.size)
+                continue;
+
+            for (std::uint8_t i = 0; i < info.site.arg_count; ++i)
+                info.types.push_back(static_cast<astra::AlogArg>(*q++));
+            info.file.assign(q, info.site.file_size);
+            q += info.site.file_size;
+            info.format.assign(q, info.site.format_size);
+            sites[info.site.id] = std::move(info);
+            continue;
+        }
+
+        const auto it = sites.find(record.site);
+        if (it == sites.end()) {
+            lines.emplace_back(record.time_ns, fmt::format("<record for unknown site {}>", record.site));
+            continue;
+        }
+        const auto &info = it->second;
+
+        const auto ns = std::chrono::nanoseconds(header.start_unix_ns + static_cast<std::int64_t>(record.time_ns));
+        const auto seconds = static_cast<std::time_t>(std::chrono::duration_cast<std::chrono::seconds>(ns).count());
+        const auto time = *std::localtime(&seconds);
+        const auto level = spdlog::level::to_short_c_str(static_cast<spdlog::level::level_enum>(info.site.level));
+        const auto text = render(info, body, body + record.size);
+
+        if (source)
+            lines.emplace_back(
+                    record.time_ns,
+                    fmt::format("[{:%H:%M:%S}] [{}] {} ({}:{})", time, level, text, info.file, info.site.line));
+        else lines.emplace_back(record.time_ns, fmt::format("[{:%H:%M:%S}] [{}] {}", time, level, text));
+    }
+
+    std::ranges::stable_sort(lines, {}, &std::pair<std::uint64_t, std::string>::first);
+    for (const auto &line: lines | std::views::values) fmt::println("{}", line);
+
+    if (p < end) fmt::println(stderr, "Stopped at a truncated record, {} bytes left over", end - p);
+    fmt::println(stderr, "{} messages, {} call sites", lines.size(), sites.size());
+}
@@ -0,0 +1,154 @@
+#include "astra/util/constexpr_hash.hpp"
+#include "astra/util/vfs.hpp"
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+/* apak <output.apak> <input dir> [--lz4]
+ *
+ * Packs every regular file under the input directory. With --lz4 each entry is compressed individually and kept
+ * compressed only if that saves at least 10%, so already compressed assets (PNGs, etc.) stay zero-copy.
+ */
+
+struct PackEntry {
+    std::string name;
+    std::uint64_t hash;
+    std::vector<char> data;
+    std::uint64_t uncompressed_size;
+    astra::ApakCompression compression;
+};
+
+std::uint64_t align_up(const std::uint64_t v, const std::uint64_t alignment) {
+    return (v + alignment - 1) / alignment * alignment;
+}
+
+std::optional<std::vector<char>> read_file(const std::filesystem::path &path) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open()) return std::nullopt;
+    return std::vector<char>(std::istreambuf_iterator(ifs), std::istreambuf_iterator<char>());
+}
+
+void try_compress(PackEntry &entry) {
+    if (entry.data.empty() || entry.data.size() > LZ4_MAX_INPUT_SIZE) return;
+
+    std::vector<char> compressed(LZ4_compressBound(static_cast<int>(entry.data.size())));
+    const auto n = LZ4_compress_HC(
+            entry.data.data(),
+            compressed.data(),
+            static_cast<int>(entry.data.size()),
+            static_cast<int>(compressed.size()),
+            LZ4HC_CLEVEL_MAX);
+    if (n <= 0 || static_cast<std::size_t>(n) > entry.data.size() * 9 / 10) return;
+
+    compressed.resize(n);
+    entry.data = std::move(compressed);
+    entry.compression = astra::ApakCompression::Lz4;
+}
+
+bool write_pack(const std::filesystem::path &path, const std::vector<PackEntry> &entries) {
+    std::string names;
+    for (const auto &e: entries) names += e.name;
+
+    astra::ApakHeader header{};
+    header.magic = astra::APAK_MAGIC;
+    header.version = astra::APAK_VERSION;
+    header.entry_count = static_cast<std::uint32_t>(entries.size());
+    header.names_size = static_cast<std::uint32_t>(names.size());
+    header.names_offset = sizeof(astra::ApakHeader) + entries.size() * sizeof(astra::ApakEntry);
+
+    std::vector<astra::ApakEntry> toc;
+    std::uint32_t name_offset = 0;
+    auto offset = align_up(header.names_offset + names.size(), astra::APAK_DATA_ALIGNMENT);
+    for (const auto &e: entries) {
+        toc.push_back(
+                {e.hash,
+                 offset,
+                 e.data.size(),
+                 e.uncompressed_size,
+                 name_offset,
+                 static_cast<std::uint32_t>(e.name.size()),
+                 e.compression,
+                 0});
+        name_offset += static_cast<std::uint32_t>(e.name.size());
+        offset = align_up(offset + e.data.size(), astra::APAK_DATA_ALIGNMENT);
+    }
+
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs.is_open()) return false;
+
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(
+            reinterpret_cast<const char *>(toc.data()),
+            static_cast<std::streamsize>(toc.size() * sizeof(astra::ApakEntry)));
+    ofs.write(names.data(), static_cast<std::streamsize>(names.size()));
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        // pad up to the aligned offset recorded in the table of contents
+        const auto pos = static_cast<std::uint64_t>(ofs.tellp());
+        for (auto p = pos; p < toc[i].offset; ++p) ofs.put('\0');
+        ofs.write(entries[i].data.data(), static_cast<std::streamsize>(entries[i].data.size()));
+    }
+
+    return ofs.good();
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fmt::println(stderr, "usage: apak <output.apak> <input dir> [--lz4]");
+        return 1;
+    }
+
+    const std::filesystem::path output = argv[1];
+    const std::filesystem::path input = argv[2];
+    const bool lz4 = argc > 3 && std::string_view(argv[3]) == "--lz4";
+
+    if (!std::filesystem::is_directory(input)) {
+        fmt::println(stderr, "'{}' is not a directory", input);
+        return 1;
+    }
+
+    std::vector<PackEntry> entries;
+    std::uint64_t total_size = 0;
+    for (const auto &e: std::filesystem::recursive_directory_iterator(input)) {
+        if (!e.is_regular_file()) continue;
+
+        auto data = read_file(e.path());
+        if (!data) {
+            fmt::println(stderr, "Failed to read '{}'", e.path());
+            return 1;
+        }
+
+        const auto name = astra::normalize_vfs_path(std::filesystem::relative(e.path(), input));
+        if (!name) {
+            fmt::println(stderr, "'{}' is outside '{}'", e.path(), input);
+            return 1;
+        }
+
+        auto &entry = entries.emplace_back(
+                *name, astra::fnv1a_64(*name), std::move(*data), 0, astra::ApakCompression::None);
+        entry.uncompressed_size = entry.data.size();
+        total_size += entry.uncompressed_size;
+        if (lz4) try_compress(entry);
+    }
+
+    std::ranges::sort(entries, [](const auto &a, const auto &b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.name < b.name;
+    });
+
+    if (!write_pack(output, entries)) {
+        fmt::println(stderr, "Failed to write '{}'", output);
+        return 1;
+    }
+
+    std::uint64_t packed_size = 0;
+    for (const auto &e: entries) packed_size += e.data.size();
+    fmt::println("{} -> {} ({} entries, {} -> {} bytes)", input, output, entries.size(), total_size, packed_size);
+    return 0;
+}
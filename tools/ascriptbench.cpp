@@ -0,0 +1,180 @@
+#include "astra/core/globals.hpp"
+#include "astra/core/payloads.hpp"
+#include "astra/util/module/script.hpp"
+#include "astra/util/module/timer_mgr.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* ascriptbench [entities] [steps]
+ *
+ * Runs the same sequence on every entity twice, once as a coroutine Script and once as the chain of TimerMgr::after
+ * callbacks it stands in for, and prints what each costs to start and to run to completion at 60 updates a second.
+ * A step waits a per-entity delay, touches the entity, waits for the next frame and touches it again. Heap allocations
+ * are counted through a replaced global operator new.
+ */
+
+std::atomic<std::size_t> allocations{0};
+
+void *operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (const auto p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+constexpr double DT = 1.0 / 60.0;
+
+struct Entity {
+    double delay;
+    int touched{0};
+    bool done{false};
+};
+
+struct Result {
+    double start_ms{0.0};
+    std::size_t start_allocations{0};
+    double run_ms{0.0};
+    double worst_frame_ms{0.0};
+    std::size_t frames{0};
+    std::size_t run_allocations{0};
+};
+
+astra::Script sequence(Entity &e, const int steps) {
+    for (int i = 0; i < steps; ++i) {
+        co_await astra::wait(e.delay);
+        ++e.touched;
+        co_await astra::next_frame();
+        ++e.touched;
+    }
+    e.done = true;
+}
+
+// after(0.0) fires on the next update, the same frame next_frame() resumes on
+void chain(astra::TimerMgr &timers, Entity &e, const int steps) {
+    if (steps == 0) {
+        e.done = true;
+        return;
+    }
+
+    timers.after(e.delay, [&timers, &e, steps] {
+        ++e.touched;
+        timers.after(0.0, [&timers, &e, steps] {
+            ++e.touched;
+            chain(timers, e, steps - 1);
+        });
+    });
+}
+
+double ms_since(const std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+template<typename Start>
+Result measure(std::vector<Entity> &entities, Start &&start) {
+    astra::TimerMgr timers;
+    Result result;
+
+    auto allocations_before = allocations.load();
+    const auto start_begin = std::chrono::steady_clock::now();
+    for (auto &e: entities) start(timers, e);
+    result.start_ms = ms_since(start_begin);
+    result.start_allocations = allocations - allocations_before;
+
+    allocations_before = allocations.load();
+    while (timers.size() > 0) {
+        const auto frame_begin = std::chrono::steady_clock::now();
+        astra::g.hermes->publish<astra::PreUpdate>(DT);
+        const auto frame_ms = ms_since(frame_begin);
+
+        result.run_ms += frame_ms;
+        result.worst_frame_ms = std::max(result.worst_frame_ms, frame_ms);
+        ++result.frames;
+    }
+    result.run_allocations = allocations - allocations_before;
+
+    return result;
+}
+
+std::vector<Entity> make_entities(const int count) {
+    std::vector<Entity> entities;
+    entities.reserve(count);
+    for (int i = 0; i < count; ++i) entities.push_back({.delay = 0.05 + 0.05 * (i % 10)}); // 50 to 500ms
+    return entities;
+}
+
+bool check(const std::vector<Entity> &entities, const int steps) {
+    return std::ranges::all_of(entities, [&](const Entity &e) { return e.done && e.touched == 2 * steps; });
+}
+
+int main(int argc, char *argv[]) {
+    const auto entity_count = argc > 1 ? std::stoi(argv[1]) : 10000;
+    const auto steps = argc > 2 ? std::stoi(argv[2]) : 8;
+    if (entity_count <= 0 || steps <= 0) {
+        fmt::println(stderr, "usage: ascriptbench [entities] [steps]");
+        return 1;
+    }
+
+    astra::g.hermes = std::make_unique<astra::Hermes>();
+
+    fmt::println("{} entities, {} steps each, {:.1f}ms updates", entity_count, steps, DT * 1000.0);
+    fmt::println(
+            "{:<10} {:>10} {:>13} {:>10} {:>7} {:>12} {:>11} {:>11}",
+            "",
+            "start",
+            "start allocs",
+            "run",
+            "frames",
+            "worst frame",
+            "run allocs",
+            "per step");
+
+    bool ok = true;
+    const auto report = [&](const std::string_view name, const Result &r, const std::vector<Entity> &entities) {
+        const auto ns_per_step = r.run_ms * 1e6 / (static_cast<double>(entity_count) * steps);
+        fmt::println(
+                "{:<10} {:>8.2f}ms {:>13} {:>8.2f}ms {:>7} {:>10.3f}ms {:>11} {:>9.0f}ns",
+                name,
+                r.start_ms,
+                r.start_allocations,
+                r.run_ms,
+                r.frames,
+                r.worst_frame_ms,
+                r.run_allocations,
+                ns_per_step);
+
+        if (!check(entities, steps)) {
+            fmt::println(stderr, "{}: not every entity ran all of its steps", name);
+            ok = false;
+        }
+    };
+
+    auto script_entities = make_entities(entity_count);
+    const auto scripts = measure(script_entities, [&](astra::TimerMgr &timers, Entity &e) {
+        timers.run(sequence(e, steps));
+    });
+    report("scripts", scripts, script_entities);
+
+    auto chain_entities = make_entities(entity_count);
+    const auto chains = measure(chain_entities, [&](astra::TimerMgr &timers, Entity &e) { chain(timers, e, steps); });
+    report("callbacks", chains, chain_entities);
+
+    astra::g.hermes.reset();
+    return ok ? 0 : 1;
+}
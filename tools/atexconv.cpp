@@ -0,0 +1,129 @@
+#include "astra/gfx/atex.hpp"
+
+#include "stb_image.h"
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+/* atexconv <input image> <output.atex> [--no-mips]
+ *
+ * Converts any image stb_image can read into a premultiplied RGBA8 ATEX file with a full mip chain.
+ */
+
+struct Image {
+    std::uint32_t width;
+    std::uint32_t height;
+    std::vector<std::uint8_t> pixels;
+};
+
+void premultiply(Image &image) {
+    for (std::size_t i = 0; i < image.pixels.size(); i += 4) {
+        const auto a = image.pixels[i + 3];
+        for (std::size_t c = 0; c < 3; ++c)
+            image.pixels[i + c] = static_cast<std::uint8_t>((image.pixels[i + c] * a + 127) / 255);
+    }
+}
+
+// 2x2 box filter, odd edges are clamped so a 5x5 image becomes 2x2 without reading out of bounds
+Image downsample(const Image &src) {
+    Image dst{std::max(src.width / 2, 1u), std::max(src.height / 2, 1u), {}};
+    dst.pixels.resize(std::size_t{dst.width} * dst.height * 4);
+
+    for (std::uint32_t y = 0; y < dst.height; ++y) {
+        const auto y0 = std::min(y * 2, src.height - 1);
+        const auto y1 = std::min(y * 2 + 1, src.height - 1);
+        for (std::uint32_t x = 0; x < dst.width; ++x) {
+            const auto x0 = std::min(x * 2, src.width - 1);
+            const auto x1 = std::min(x * 2 + 1, src.width - 1);
+            for (std::size_t c = 0; c < 4; ++c) {
+                const auto sum = src.pixels[(std::size_t{y0} * src.width + x0) * 4 + c] +
+                                 src.pixels[(std::size_t{y0} * src.width + x1) * 4 + c] +
+                                 src.pixels[(std::size_t{y1} * src.width + x0) * 4 + c] +
+                                 src.pixels[(std::size_t{y1} * src.width + x1) * 4 + c];
+                dst.pixels[(std::size_t{y} * dst.width + x) * 4 + c] = static_cast<std::uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+
+    return dst;
+}
+
+std::uint64_t align_up(const std::uint64_t v, const std::uint64_t alignment) {
+    return (v + alignment - 1) / alignment * alignment;
+}
+
+bool write_atex(const std::filesystem::path &path, const std::vector<Image> &mips) {
+    astra::AtexHeader header{};
+    header.magic = astra::ATEX_MAGIC;
+    header.version = astra::ATEX_VERSION;
+    header.format = astra::AtexFormat::Rgba8Premultiplied;
+    header.width = mips.front().width;
+    header.height = mips.front().height;
+    header.mip_count = static_cast<std::uint32_t>(mips.size());
+
+    std::vector<astra::AtexMip> index;
+    const auto index_end = sizeof(astra::AtexHeader) + mips.size() * sizeof(astra::AtexMip);
+    auto offset = align_up(index_end, astra::ATEX_DATA_ALIGNMENT);
+    for (const auto &mip: mips) {
+        index.push_back({offset, mip.pixels.size(), mip.width, mip.height});
+        offset = align_up(offset + mip.pixels.size(), astra::ATEX_DATA_ALIGNMENT);
+    }
+
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs.is_open()) return false;
+
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(
+            reinterpret_cast<const char *>(index.data()),
+            static_cast<std::streamsize>(index.size() * sizeof(astra::AtexMip)));
+    for (std::size_t i = 0; i < mips.size(); ++i) {
+        // pad up to the aligned offset recorded in the index
+        const auto pos = static_cast<std::uint64_t>(ofs.tellp());
+        for (auto p = pos; p < index[i].offset; ++p) ofs.put('\0');
+        ofs.write(
+                reinterpret_cast<const char *>(mips[i].pixels.data()),
+                static_cast<std::streamsize>(mips[i].pixels.size()));
+    }
+
+    return ofs.good();
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fmt::println(stderr, "usage: atexconv <input image> <output.atex> [--no-mips]");
+        return 1;
+    }
+
+    const std::filesystem::path input = argv[1];
+    const std::filesystem::path output = argv[2];
+    const bool gen_mips = !(argc > 3 && std::string_view(argv[3]) == "--no-mips");
+
+    int w, h, channels;
+    const auto bytes = stbi_load(input.string().c_str(), &w, &h, &channels, STBI_rgb_alpha);
+    if (!bytes) {
+        fmt::println(stderr, "Failed to load image from '{}': {}", input, stbi_failure_reason());
+        return 1;
+    }
+
+    std::vector<Image> mips;
+    mips.push_back({static_cast<std::uint32_t>(w),
+                    static_cast<std::uint32_t>(h),
+                    std::vector<std::uint8_t>(bytes, bytes + std::size_t{static_cast<std::uint32_t>(w * h)} * 4)});
+    stbi_image_free(bytes);
+
+    premultiply(mips.front());
+    while (gen_mips && (mips.back().width > 1 || mips.back().height > 1)) mips.push_back(downsample(mips.back()));
+
+    if (!write_atex(output, mips)) {
+        fmt::println(stderr, "Failed to write '{}'", output);
+        return 1;
+    }
+
+    fmt::println("{} -> {} ({}x{}, {} mips)", input, output, w, h, mips.size());
+    return 0;
+}